@@ -0,0 +1,495 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_columnar_sink.h"
+#include "csv_parallel_parser.h"
+#include "csv_parser.h"
+#include "csv_writer.h"
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Two parsers are equivalent in speed if neither completes more than this
+/// number of milliseconds before the other (see the ranking methodology in
+/// design_and_implementation_of_a_streaming_csv_parser.md).
+const double equivalence_time = 250;
+
+struct bench_options {
+    std::string data_dir {"csv_parser_bench_data"}; // directory of the generated datasets
+    unsigned int runs {3};                          // runs per mode and dataset, the fastest being kept
+    bool large {false};                             // whether the 1 GB and 10 GB datasets are included
+    std::vector<std::string> datasets;              // names of the datasets to run (all if empty)
+    std::string json_path;                          // file receiving results as JSON (none if empty)
+};
+
+/// A generated CSV file: raw_c_l holds no double quotes while quotes_c_l
+/// encloses every field in double quotes, c being the number of columns and
+/// l the number of lines.
+struct dataset {
+    bool quotes;
+    unsigned int columns;
+    std::uint64_t lines;
+    bool large;
+
+    std::string name() const
+    {
+        return (quotes ? "quotes_" : "raw_") + std::to_string(columns) + "_" + std::to_string(lines);
+    }
+};
+
+enum class parser_mode { scalar, simd, separator_set, parallel, columnar, rewrite };
+
+const parser_mode all_modes[] = {
+    parser_mode::scalar, parser_mode::simd, parser_mode::separator_set, parser_mode::parallel,
+    parser_mode::columnar, parser_mode::rewrite,
+};
+
+/// Result of parsing a dataset in a given mode.
+struct run_result {
+    parser_mode mode;
+    double elapsed_time {0};      // in milliseconds, for the fastest run
+    std::uint64_t bytes {0};
+    std::uint64_t records {0};
+    std::uint64_t fields {0};
+    long peak_memory {0};         // maximum resident set size in KiB
+    unsigned int rank {0};
+    bool ok {false};
+
+    double megabytes_per_second() const
+    { return elapsed_time > 0 ? bytes / (1024.0 * 1024.0) / (elapsed_time / 1000) : 0; }
+
+    double records_per_second() const
+    { return elapsed_time > 0 ? records / (elapsed_time / 1000) : 0; }
+};
+
+/// Deterministic pseudo-random number generator (xorshift64).
+class xorshift64
+{
+public:
+    explicit xorshift64(std::uint64_t seed) : m_state(seed ? seed : 1) {}
+
+    std::uint64_t next()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return m_state;
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+const char* mode_name(parser_mode mode)
+{
+    switch(mode) {
+    case parser_mode::scalar: return "scalar";
+    case parser_mode::simd: return "simd";
+    case parser_mode::separator_set: return "separator_set";
+    case parser_mode::parallel: return "parallel";
+    case parser_mode::columnar: return "columnar";
+    case parser_mode::rewrite: return "rewrite";
+    }
+    return "";
+}
+
+std::vector<dataset> all_datasets()
+{
+    std::vector<dataset> datasets;
+    for(const bool quotes : {false, true}) {
+        for(const std::uint64_t lines : {10000ull, 100000ull}) {
+            for(const unsigned int columns : {10u, 100u}) {
+                datasets.push_back({quotes, columns, lines, false});
+            }
+        }
+        // About 1 GB and 10 GB (raw) or 1.5 GB and 15 GB (quotes).
+        datasets.push_back({quotes, 100, 1000000, true});
+        datasets.push_back({quotes, 100, 10000000, true});
+    }
+    return datasets;
+}
+
+/// Writes the content of a dataset to a file. Fields are made of 4 to 12
+/// letters and digits; in quoted datasets, one field out of eight also holds
+/// a field separator, a line separator or an escaped double quote.
+bool generate_dataset(const dataset &ds, const std::string &path)
+{
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    static const char *specials[] = {",", "\n", "\"\""};
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()) {
+        return false;
+    }
+
+    xorshift64 rng(0x9E3779B97F4A7C15ull ^ (ds.columns * 1000003ull + ds.lines) ^ (ds.quotes ? 1 : 0));
+    std::string buffer;
+    for(std::uint64_t line = 0; line < ds.lines; line++) {
+        for(unsigned int column = 0; column < ds.columns; column++) {
+            if(column > 0) {
+                buffer += ',';
+            }
+            if(ds.quotes) {
+                buffer += '"';
+            }
+            const unsigned int length = 4 + rng.next() % 9;
+            for(unsigned int i = 0; i < length; i++) {
+                buffer += alphabet[rng.next() % (sizeof(alphabet) - 1)];
+            }
+            if(ds.quotes && rng.next() % 8 == 0) {
+                buffer += specials[rng.next() % 3];
+            }
+            if(ds.quotes) {
+                buffer += '"';
+            }
+        }
+        buffer += '\n';
+        if(buffer.size() >= (1 << 20)) {
+            file.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    file.write(buffer.data(), buffer.size());
+    return static_cast<bool>(file);
+}
+
+/// Parses a file in the given mode, in the calling process.
+run_result parse_file(parser_mode mode, const std::string &path)
+{
+    run_result result;
+    result.mode = mode;
+
+    std::uint64_t records = 0;
+    std::uint64_t fields = 0;
+    const csv_parser::record_callback &count = [&](const csv_record &record) {
+        records++;
+        fields += record.size();
+    };
+
+    const auto begin = std::chrono::steady_clock::now();
+    if(mode == parser_mode::parallel) {
+        csv_parallel_parser parser{csv_parallel_parser::options()};
+        if(!parser.parse_file(path, count)) {
+            return result;
+        }
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        result.bytes = static_cast<std::uint64_t>(file.tellg());
+    }
+    else {
+        std::ifstream file(path, std::ios::binary);
+        if(!file.is_open()) {
+            return result;
+        }
+
+        csv_parser::options opts;
+        opts.simd_scan = mode != parser_mode::scalar;
+        if(mode == parser_mode::separator_set) {
+            // a superset of the separators of the datasets, with more first
+            // characters than can be compared one at a time
+            opts.field_separators = {",", ";", "\t", "|", "  ", "::", "~~", "^"};
+            opts.line_separators = {"\r\n", "\n", "\r", "<br>", "\x1e"};
+        }
+        csv_columnar_sink::options sink_opts;
+        sink_opts.header = false;
+        csv_columnar_sink sink([&](const csv_batch &batch) {
+            records += batch.rows;
+            fields += batch.rows * batch.columns.size();
+        }, sink_opts);
+        // rewrite parses records and writes them back, output being discarded
+        csv_writer::options writer_opts;
+        writer_opts.line_separator = "\n";
+        csv_writer writer([](const char *, size_t) {}, writer_opts);
+        const csv_parser::record_callback &rewrite = [&](const csv_record &record) {
+            count(record);
+            writer.write_record(record);
+        };
+        csv_parser parser(mode == parser_mode::columnar ? sink.record_callback()
+                        : mode == parser_mode::rewrite ? rewrite : count, opts);
+
+        std::vector<char> chunk(1 << 20);
+        while(file) {
+            file.read(chunk.data(), chunk.size());
+            const size_t size = static_cast<size_t>(file.gcount());
+            result.bytes += size;
+            parser.parse(chunk.data(), size);
+        }
+        parser.end();
+        sink.flush();
+        writer.flush();
+    }
+    result.elapsed_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    result.records = records;
+    result.fields = fields;
+    result.ok = true;
+    return result;
+}
+
+/// Same as above in a child process, so that the peak memory usage of each
+/// run can be measured on its own.
+run_result parse_file_in_child(parser_mode mode, const std::string &path)
+{
+    run_result result;
+    result.mode = mode;
+
+    int fds[2];
+    if(pipe(fds) != 0) {
+        return result;
+    }
+    const pid_t pid = fork();
+    if(pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return result;
+    }
+    if(pid == 0) {
+        close(fds[0]);
+        const run_result &child_result = parse_file(mode, path);
+        const ssize_t written = write(fds[1], &child_result, sizeof(child_result));
+        _exit(written == sizeof(child_result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    const ssize_t read_size = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage;
+    if(wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0
+       || read_size != sizeof(result)) {
+        result = run_result();
+        result.mode = mode;
+        return result;
+    }
+    result.peak_memory = usage.ru_maxrss; // in KiB on Linux
+    return result;
+}
+
+/// Ranks results sorted by increasing time: a result gets the rank of the
+/// fastest result of the current rank if it completes at most
+/// equivalence_time after it, and starts the next rank otherwise.
+void rank_results(std::vector<run_result> &results)
+{
+    unsigned int rank = 0;
+    double rank_time = 0;
+    for(run_result &result : results) {
+        if(rank == 0 || result.elapsed_time > rank_time + equivalence_time) {
+            rank++;
+            rank_time = result.elapsed_time;
+        }
+        result.rank = rank;
+    }
+}
+
+std::string json_str(const dataset &ds, const std::vector<run_result> &results)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3)
+           << "    {\"name\": \"" << ds.name() << "\", \"columns\": " << ds.columns
+           << ", \"lines\": " << ds.lines
+           << ", \"bytes\": " << (results.empty() ? 0 : results[0].bytes)
+           << ", \"results\": [";
+    for(size_t i = 0; i < results.size(); i++) {
+        const run_result &result = results[i];
+        stream << (i > 0 ? ", " : "") << "\n        "
+               << "{\"mode\": \"" << mode_name(result.mode) << "\""
+               << ", \"rank\": " << result.rank
+               << ", \"time_ms\": " << result.elapsed_time
+               << ", \"megabytes_per_second\": " << result.megabytes_per_second()
+               << ", \"records\": " << result.records
+               << ", \"records_per_second\": " << result.records_per_second()
+               << ", \"peak_memory_kib\": " << result.peak_memory << "}";
+    }
+    stream << "\n    ]}";
+    return stream.str();
+}
+
+void print_usage(const std::string &program)
+{
+    std::cerr << "usage: " << program << " [--dir <data directory>] [--runs <count>]"
+                 " [--large] [--dataset <name>]... [--json <file>]" << std::endl
+              << std::endl
+              << "Generates the raw_c_l and quotes_c_l datasets (c columns, l lines)"
+                 " in the data directory if missing, parses each of them with"
+                 " every parser mode, and ranks modes by time using a "
+              << equivalence_time << " ms equivalence threshold. The 1 GB and"
+                 " 10 GB datasets are only included with --large or --dataset."
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    bench_options opts;
+    try {
+        for(size_t i = 0; i < args.size(); i++) {
+            if(args[i] == "--dir" && i + 1 < args.size()) {
+                opts.data_dir = args[++i];
+            }
+            else if(args[i] == "--runs" && i + 1 < args.size()) {
+                opts.runs = std::max(1ul, std::stoul(args[++i]));
+            }
+            else if(args[i] == "--large") {
+                opts.large = true;
+            }
+            else if(args[i] == "--dataset" && i + 1 < args.size()) {
+                opts.datasets.push_back(args[++i]);
+            }
+            else if(args[i] == "--json" && i + 1 < args.size()) {
+                opts.json_path = args[++i];
+            }
+            else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch(const std::logic_error &) { // std::invalid_argument or std::out_of_range
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<dataset> datasets;
+    for(const dataset &ds : all_datasets()) {
+        const bool selected = opts.datasets.empty()
+            ? opts.large || !ds.large
+            : std::find(opts.datasets.begin(), opts.datasets.end(), ds.name()) != opts.datasets.end();
+        if(selected) {
+            datasets.push_back(ds);
+        }
+    }
+    if(datasets.empty()) {
+        std::cerr << "[-] no dataset selected" << std::endl;
+        return 1;
+    }
+
+    if(mkdir(opts.data_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cerr << "[-] unable to create directory " << opts.data_dir << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    std::vector<std::string> json_datasets;
+    for(const dataset &ds : datasets) {
+        const std::string &path = opts.data_dir + "/" + ds.name() + ".csv";
+        if(!std::ifstream(path).is_open()) {
+            std::cout << "[-] generating " << path << std::endl;
+            if(!generate_dataset(ds, path)) {
+                std::cerr << "[-] unable to write " << path << std::endl;
+                return 1;
+            }
+        }
+
+        std::vector<run_result> results;
+        for(const parser_mode mode : all_modes) {
+            run_result best;
+            for(unsigned int run = 0; run < opts.runs; run++) {
+                const run_result &result = parse_file_in_child(mode, path);
+                if(!result.ok) {
+                    best = result;
+                    break;
+                }
+                if(!best.ok || result.elapsed_time < best.elapsed_time) {
+                    const long peak_memory = std::max(best.peak_memory, result.peak_memory);
+                    best = result;
+                    best.peak_memory = peak_memory;
+                }
+                else {
+                    best.peak_memory = std::max(best.peak_memory, result.peak_memory);
+                }
+            }
+            if(!best.ok) {
+                std::cerr << "[-] " << ds.name() << ": " << mode_name(mode) << " run failed" << std::endl;
+                ok = false;
+                continue;
+            }
+            results.push_back(best);
+        }
+        if(results.empty()) {
+            continue;
+        }
+
+        std::sort(results.begin(), results.end(), [](const run_result &a, const run_result &b) {
+            return a.elapsed_time < b.elapsed_time;
+        });
+        rank_results(results);
+
+        std::cout << "[-] " << ds.name() << " (" << results[0].bytes << " bytes, "
+                  << results[0].records << " records)" << std::endl;
+        std::string summary;
+        for(const run_result &result : results) {
+            std::cout << "    " << result.rank << ". " << mode_name(result.mode) << ": "
+                      << std::fixed << std::setprecision(1) << result.elapsed_time << " ms, "
+                      << result.megabytes_per_second() << " MB/s, "
+                      << static_cast<long long>(result.records_per_second()) << " records/s, "
+                      << result.peak_memory / 1024.0 << " MiB peak memory" << std::endl;
+            if(result.records != results[0].records || result.fields != results[0].fields) {
+                std::cout << "    unexpected number of records or fields in "
+                          << mode_name(result.mode) << " mode" << std::endl;
+                ok = false;
+            }
+            std::ostringstream entry;
+            entry << std::fixed << std::setprecision(1) << result.elapsed_time;
+            summary += (summary.empty() ? "" : " / ") + std::to_string(result.rank) + ". "
+                     + mode_name(result.mode) + " (" + entry.str() + ")";
+        }
+        std::cout << "    " << summary << std::endl;
+        json_datasets.push_back(json_str(ds, results));
+    }
+
+    if(!opts.json_path.empty()) {
+        std::ofstream json(opts.json_path, std::ios::trunc);
+        json << "{\n  \"runs\": " << opts.runs
+             << ",\n  \"equivalence_time_ms\": " << equivalence_time
+             << ",\n  \"datasets\": [\n";
+        for(size_t i = 0; i < json_datasets.size(); i++) {
+            json << json_datasets[i] << (i + 1 < json_datasets.size() ? ",\n" : "\n");
+        }
+        json << "  ]\n}\n";
+        if(!json) {
+            std::cerr << "[-] unable to write " << opts.json_path << std::endl;
+            return 1;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,393 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_columnar_sink.h"
+#include "csv_parallel_parser.h"
+#include "csv_parser.h"
+#include "csv_record_index.h"
+#include "csv_writer.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string &title_prefix = "--- ";
+const std::string &title_suffix = " ---";
+const std::string &msg_prefix1  = "[-] ";
+const std::string &msg_prefix2  = "    ";
+
+std::string title_str(const std::string &str)
+{
+    return title_prefix + str + title_suffix;
+}
+
+/// Returns a printable version of str, with line breaks escaped.
+std::string printable_str(const std::string &str)
+{
+    std::string out;
+    for(const char c : str) {
+        switch(c) {
+        case '\r': out += "\\r"; break;
+        case '\n': out += "\\n"; break;
+        default: out += c; break;
+        }
+    }
+    return out;
+}
+
+std::string record_str(const csv_record &record)
+{
+    std::string out = "[";
+    for(size_t i = 0; i < record.size(); i++) {
+        out += (i > 0 ? ", " : "") + ("\"" + printable_str(record[i].str()) + "\"");
+    }
+    out += "]";
+    for(const csv_warning &warning : record.warnings) {
+        out += warning.type == csv_warning_type::missing_end_quote
+             ? " W_1" : " W_2";
+        out += "(field " + std::to_string(warning.field_index) + ")";
+    }
+    return out;
+}
+
+/// Parses data in chunks of the given size and returns the records read.
+std::vector<std::string> parse_in_chunks(const std::string &data,
+                                         size_t chunk_size,
+                                         const csv_parser::options &opts)
+{
+    std::vector<std::string> records;
+    csv_parser parser([&](const csv_record &record) {
+        records.push_back(record_str(record));
+    }, opts);
+    for(size_t i = 0; i < data.size(); i += chunk_size) {
+        parser.parse(data.data() + i, std::min(chunk_size, data.size() - i));
+    }
+    parser.end();
+    return records;
+}
+
+void parse_sample(const std::string &data, const csv_parser::options &opts)
+{
+    std::cout << "parsing \"" << printable_str(data) << "\"" << std::endl;
+    const std::vector<std::string> &records = parse_in_chunks(data, data.size() + 1, opts);
+    for(const std::string &record : records) {
+        std::cout << msg_prefix2 << record << std::endl;
+    }
+
+    // The records must not depend on how the input is split into chunks.
+    for(size_t chunk_size = 1; chunk_size <= data.size(); chunk_size++) {
+        if(parse_in_chunks(data, chunk_size, opts) != records) {
+            std::cout << msg_prefix2 << "unexpected records when parsing in chunks of "
+                      << chunk_size << " bytes" << std::endl;
+        }
+    }
+}
+
+void parse_samples()
+{
+    const csv_parser::options default_opts;
+    parse_sample("a,\"b,b\",c", default_opts);
+    parse_sample("a,ab,a\",a\"b\"", default_opts);
+    parse_sample("\"a\"\"b\"", default_opts);
+    parse_sample("\"a\"\"", default_opts);
+    parse_sample("\"a\"x,b", default_opts);
+    parse_sample("\"a\"  ", default_opts);
+    parse_sample("a,b\r\nc,d\re,f\ng,h\n", default_opts);
+    parse_sample("a,\n\n,b\n", default_opts);
+    parse_sample("\"multi\r\nline\",\"\"\r\n", default_opts);
+
+    csv_parser::options opts;
+    opts.field_separators = {";", "\t", "  "};
+    opts.line_separators = {"\r\n", "\n", "\r", "<br>"};
+    std::cout << "using ; \\t and two spaces as field separators and <br> as"
+                 " an additional line separator" << std::endl;
+    parse_sample("a;b\tc  d<br>\"e;<br>\";f", opts);
+}
+
+void compare_scan_methods()
+{
+    // Samples are repeated so that input holds several blocks of bytes.
+    std::string data;
+    for(int i = 0; i < 16; i++) {
+        data += "a,\"b,b\",c\r\n\"a\"\"b\",a\"b\",\"a\"x,b\"\n\n,\"multi\r\nline\"\r";
+    }
+    data += "\"a\"\"";
+
+    csv_parser::options simd_opts;
+    csv_parser::options scalar_opts;
+    scalar_opts.simd_scan = false;
+    const std::vector<std::string> &records = parse_in_chunks(data, data.size(), scalar_opts);
+    std::cout << msg_prefix1 << records.size() << " records read from "
+              << data.size() << " bytes" << std::endl;
+
+    bool same_records = true;
+    for(size_t chunk_size = 1; chunk_size <= data.size(); chunk_size++) {
+        if(parse_in_chunks(data, chunk_size, simd_opts) != records) {
+            std::cout << msg_prefix2 << "unexpected records when parsing in chunks of "
+                      << chunk_size << " bytes using SIMD scan" << std::endl;
+            same_records = false;
+        }
+    }
+    std::cout << msg_prefix2
+              << (same_records ? "SIMD scan and scalar parsing read the same records"
+                               : "SIMD scan and scalar parsing read different records")
+              << std::endl;
+}
+
+std::string column_value_str(const csv_column &column, size_t row)
+{
+    if(!column.present[row]) {
+        return "-";
+    }
+    switch(column.type) {
+    case csv_column_type::none: return "-";
+    case csv_column_type::boolean: return column.booleans[row] ? "true" : "false";
+    case csv_column_type::integer: return std::to_string(column.integers[row]);
+    case csv_column_type::floating: return std::to_string(column.floats[row]);
+    case csv_column_type::string: return "\"" + printable_str(column.string_at(row).str()) + "\"";
+    }
+    return "";
+}
+
+void read_columns()
+{
+    const std::string &data =
+        "id,name,price,available,note\n"
+        "1,apple,0.5,true,\n"
+        "2,pear,1,FALSE,\"ripe\"\n"
+        "3,\"plum, red\",2.25,true,\n"
+        "4,fig,,false,new\n"
+        "5,lime,3,yes\n";
+    std::cout << "parsing \"" << printable_str(data) << "\" in batches of at most 3 rows"
+              << std::endl;
+
+    csv_columnar_sink::options opts;
+    opts.batch_rows = 3;
+    csv_columnar_sink sink([](const csv_batch &batch) {
+        std::cout << msg_prefix1 << "rows " << batch.first_row << " to "
+                  << batch.first_row + batch.rows - 1 << std::endl;
+        for(const csv_column &column : batch.columns) {
+            std::string values;
+            for(size_t row = 0; row < batch.rows; row++) {
+                values += (row > 0 ? ", " : "") + column_value_str(column, row);
+            }
+            std::cout << msg_prefix2 << column.name << " ("
+                      << csv_columnar_sink::type_name(column.type) << "): "
+                      << values << std::endl;
+        }
+    }, opts);
+    csv_parser parser(sink.record_callback());
+    parser.parse(data);
+    parser.end();
+    sink.flush();
+    std::cout << msg_prefix2 << sink.run_stats().descr() << std::endl;
+}
+
+void write_records()
+{
+    const std::vector<std::vector<std::string>> &records {
+        {"id", "name", "note"},
+        {"1", "plain", ""},
+        {"2", "a,b", "say \"hi\""},
+        {"3", "multi\r\nline", std::string(100, 'x')},
+    };
+    std::string output;
+    csv_writer::options opts;
+    opts.zero_copy_size = 64;
+    csv_writer writer([&](const char *data, size_t size) { output.append(data, size); }, opts);
+    for(const std::vector<std::string> &fields : records) {
+        writer.write_record(fields);
+    }
+    writer.flush();
+    std::cout << msg_prefix1 << "wrote \"" << printable_str(output) << "\"" << std::endl;
+    std::cout << msg_prefix2 << writer.run_stats().descr() << std::endl;
+
+    // Written records must be read back exactly.
+    std::vector<std::vector<std::string>> read_records;
+    csv_parser parser([&](const csv_record &record) {
+        read_records.push_back(record.strings());
+    }, writer.parser_options());
+    parser.parse(output);
+    parser.end();
+    std::cout << msg_prefix2
+              << (read_records == records ? "records read back are the records written"
+                                          : "records read back differ from the records written")
+              << std::endl;
+}
+
+bool parse_file(const std::string &filename, bool simd_scan)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if(!file.is_open()) {
+        std::cout << msg_prefix1 << "unable to open file " << filename << std::endl;
+        return false;
+    }
+
+    std::uint64_t field_count = 0;
+    std::uint64_t warning_count = 0;
+    csv_parser::options opts;
+    opts.simd_scan = simd_scan;
+    csv_parser parser([&](const csv_record &record) {
+        field_count += record.size();
+        warning_count += record.warnings.size();
+    }, opts);
+
+    const auto begin = std::chrono::steady_clock::now();
+    std::uint64_t byte_count = 0;
+    std::vector<char> chunk(1 << 20);
+    while(file) {
+        file.read(chunk.data(), chunk.size());
+        const size_t size = static_cast<size_t>(file.gcount());
+        byte_count += size;
+        parser.parse(chunk.data(), size);
+    }
+    parser.end();
+    const double elapsed_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << msg_prefix1 << "parsed " << filename
+              << (simd_scan ? " (SIMD scan): " : " (scalar): ")
+              << byte_count << " bytes, "
+              << parser.record_count() << " records, "
+              << field_count << " fields, "
+              << warning_count << " warnings in "
+              << static_cast<long long>(elapsed_time) << " ms ("
+              << (elapsed_time > 0 ? byte_count / (1024.0 * 1024.0) / (elapsed_time / 1000) : 0)
+              << " MB/s)" << std::endl;
+    return true;
+}
+
+bool parse_file_in_parallel(const std::string &filename)
+{
+    std::uint64_t record_count = 0;
+    std::uint64_t field_count = 0;
+    std::uint64_t warning_count = 0;
+    csv_parallel_parser parser{csv_parallel_parser::options()};
+
+    const auto begin = std::chrono::steady_clock::now();
+    const bool ok = parser.parse_file(filename, [&](const csv_record &record) {
+        record_count++;
+        field_count += record.size();
+        warning_count += record.warnings.size();
+    });
+    const double elapsed_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    if(!ok) {
+        std::cout << msg_prefix1 << parser.error() << std::endl;
+        return false;
+    }
+
+    std::cout << msg_prefix1 << "parsed " << filename << " (parallel): "
+              << record_count << " records, "
+              << field_count << " fields, "
+              << warning_count << " warnings in "
+              << static_cast<long long>(elapsed_time) << " ms ("
+              << parser.run_stats().descr() << ")" << std::endl;
+    return true;
+}
+
+bool index_file(const std::string &filename)
+{
+    const std::string &index_filename = filename + ".idx";
+    csv_record_index::options opts;
+    csv_record_index index(opts);
+
+    auto begin = std::chrono::steady_clock::now();
+    if(!index.build(filename, index_filename)) {
+        std::cout << msg_prefix1 << index.error() << std::endl;
+        return false;
+    }
+    double elapsed_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    std::cout << msg_prefix1 << "indexed " << filename << ": "
+              << index.record_count() << " records, "
+              << index.checkpoint_count() << " checkpoints saved to " << index_filename
+              << " in " << static_cast<long long>(elapsed_time) << " ms" << std::endl;
+
+    csv_record_index loaded_index(opts);
+    if(!loaded_index.load(index_filename, filename)) {
+        std::cout << msg_prefix2 << loaded_index.error() << std::endl;
+        return false;
+    }
+    const std::uint64_t first = loaded_index.record_count() / 2;
+    std::uint64_t record_count = 0;
+    std::uint64_t begin_offset = 0;
+    begin = std::chrono::steady_clock::now();
+    loaded_index.parse_records(filename, first, 10, [&](const csv_record &record) {
+        if(record_count++ == 0) {
+            begin_offset = record.begin_offset;
+        }
+    });
+    elapsed_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    std::cout << msg_prefix2 << "read " << record_count << " records from record " << first
+              << " (offset " << begin_offset << ") using the loaded index in "
+              << elapsed_time << " ms" << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if(argc > 1) {
+        bool ok = true;
+        for(int i = 1; i < argc; i++) {
+            ok = parse_file(argv[i], true) && parse_file(argv[i], false)
+              && parse_file_in_parallel(argv[i]) && index_file(argv[i]) && ok;
+        }
+        return ok ? 0 : 1;
+    }
+
+    std::cout << title_str("Parse sample CSV strings") << std::endl;
+    parse_samples();
+    std::cout << std::endl;
+
+    std::cout << title_str("Compare SIMD scan and scalar parsing") << std::endl;
+    compare_scan_methods();
+    std::cout << std::endl;
+
+    std::cout << title_str("Read sample CSV data into typed columns") << std::endl;
+    read_columns();
+    std::cout << std::endl;
+
+    std::cout << title_str("Write sample records and read them back") << std::endl;
+    write_records();
+    std::cout << std::endl;
+
+    std::cout << title_str("Finished parsing sample data") << std::endl;
+    std::cout << msg_prefix2
+              << "pass file names as arguments to parse files, measure "
+                 "throughput and index records (written to <file>.idx)"
+              << std::endl;
+    std::cout << std::endl;
+
+    return 0;
+}
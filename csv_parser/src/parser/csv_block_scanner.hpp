@@ -0,0 +1,278 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_BLOCK_SCANNER_H
+#define CSV_BLOCK_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CSV_BLOCK_SCANNER_AVX2 // compiled for AVX2 and selected at runtime
+#endif
+
+/// Classifies blocks of 64 bytes at once, returning bitmasks where bit i
+/// corresponds to byte i of the block. AVX2 or SSSE3 instructions are used
+/// when the CPU supports them, otherwise SSE2 instructions when available,
+/// which is always the case on x86-64.
+///
+/// With AVX2 or SSSE3, bytes are classified using two shuffles (pshufb) as
+/// lookup tables indexed by their low and high nibbles, whatever the number
+/// of characters to detect. Characters are grouped by high nibble, each group
+/// being given one bit: a byte belongs to the set if the entry of its high
+/// nibble and the entry of its low nibble share a bit. This is exact for up to
+/// 8 distinct high nibbles; beyond that, groups share bits and the bytes
+/// detected by mistake are removed using a lookup table.
+class csv_block_scanner
+{
+public:
+    static const size_t block_size = 64;
+
+    /// Builds a scanner detecting double quotes and the given characters
+    /// (usually the first characters of the field and line separators).
+    explicit csv_block_scanner(const std::vector<char> &chars)
+        : m_chars(chars)
+    {
+#if defined(CSV_BLOCK_SCANNER_AVX2)
+        m_use_avx2 = __builtin_cpu_supports("avx2");
+        m_use_ssse3 = __builtin_cpu_supports("ssse3");
+#endif
+        for(bool &b : m_is_char) {
+            b = false;
+        }
+        for(const char c : m_chars) {
+            m_is_char[static_cast<unsigned char>(c)] = true;
+        }
+
+        std::uint8_t high_nibble_bits[16] = {0};
+        size_t high_nibble_count = 0;
+        for(std::uint8_t &entry : m_low_nibbles) {
+            entry = 0;
+        }
+        for(std::uint8_t &entry : m_high_nibbles) {
+            entry = 0;
+        }
+        for(const char c : m_chars) {
+            const unsigned char uc = static_cast<unsigned char>(c);
+            std::uint8_t &bit = high_nibble_bits[uc >> 4];
+            if(!bit) {
+                bit = static_cast<std::uint8_t>(1u << (high_nibble_count++ % 8));
+            }
+            m_high_nibbles[uc >> 4] |= bit;
+            m_low_nibbles[uc & 0xF] |= bit;
+        }
+        m_nibbles_exact = high_nibble_count <= 8;
+    }
+
+    /// Sets quotes and chars to the masks of double quotes and of the
+    /// characters given at construction in the block_size bytes of block.
+    void classify(const char *block,
+                  std::uint64_t &quotes,
+                  std::uint64_t &chars) const
+    {
+#if defined(CSV_BLOCK_SCANNER_AVX2)
+        if(m_use_avx2) {
+            classify_avx2(block, quotes, chars);
+            return;
+        }
+        if(m_use_ssse3) {
+            classify_ssse3(block, quotes, chars);
+            return;
+        }
+#endif
+#if defined(__SSE2__)
+        if(m_chars.size() <= simd_chars_max) {
+            quotes = 0;
+            chars = 0;
+            const __m128i quote = _mm_set1_epi8('"');
+            for(size_t i = 0; i < block_size; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+                const std::uint64_t q = static_cast<std::uint32_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)));
+                __m128i matches = _mm_setzero_si128();
+                for(const char c : m_chars) {
+                    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c)));
+                }
+                const std::uint64_t m = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+                quotes |= q << i;
+                chars |= m << i;
+            }
+            return;
+        }
+#endif
+        classify_scalar(block, quotes, chars);
+    }
+
+    /// Same as classify() without SIMD instructions.
+    void classify_scalar(const char *block,
+                         std::uint64_t &quotes,
+                         std::uint64_t &chars) const
+    {
+        quotes = 0;
+        chars = 0;
+        for(size_t i = 0; i < block_size; i++) {
+            const unsigned char c = static_cast<unsigned char>(block[i]);
+            quotes |= static_cast<std::uint64_t>(c == '"') << i;
+            chars |= static_cast<std::uint64_t>(m_is_char[c]) << i;
+        }
+    }
+
+#if defined(CSV_BLOCK_SCANNER_AVX2)
+    /// Same as classify() using AVX2 instructions, which the CPU must support.
+    __attribute__((target("avx2")))
+    void classify_avx2(const char *block,
+                       std::uint64_t &quotes,
+                       std::uint64_t &chars) const
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+        const __m256i low_table = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_low_nibbles)));
+        const __m256i high_table = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_high_nibbles)));
+        quotes = 0;
+        chars = 0;
+        for(size_t i = 0; i < block_size; i += 32) {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i));
+            const __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(bytes, nibble_mask));
+            const __m256i high = _mm256_shuffle_epi8(
+                high_table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble_mask));
+            const __m256i no_match = _mm256_cmpeq_epi8(_mm256_and_si256(low, high),
+                                                       _mm256_setzero_si256());
+            const std::uint64_t q = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote)));
+            const std::uint64_t m = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(no_match));
+            quotes |= q << i;
+            chars |= m << i;
+        }
+        if(!m_nibbles_exact) {
+            chars = filter_chars(block, chars);
+        }
+    }
+
+    /// Same as classify() using SSSE3 instructions, which the CPU must
+    /// support.
+    __attribute__((target("ssse3")))
+    void classify_ssse3(const char *block,
+                        std::uint64_t &quotes,
+                        std::uint64_t &chars) const
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+        const __m128i low_table = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_low_nibbles));
+        const __m128i high_table = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m_high_nibbles));
+        quotes = 0;
+        chars = 0;
+        for(size_t i = 0; i < block_size; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+            const __m128i low = _mm_shuffle_epi8(low_table, _mm_and_si128(bytes, nibble_mask));
+            const __m128i high = _mm_shuffle_epi8(
+                high_table, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask));
+            const __m128i no_match = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+            const std::uint64_t q = static_cast<std::uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)));
+            const std::uint64_t m = static_cast<std::uint32_t>(
+                ~_mm_movemask_epi8(no_match) & 0xFFFF);
+            quotes |= q << i;
+            chars |= m << i;
+        }
+        if(!m_nibbles_exact) {
+            chars = filter_chars(block, chars);
+        }
+    }
+#endif
+
+    /// Returns the mask where bit i is the XOR of bits 0 to i of mask. Given
+    /// the mask of double quotes of a block, this is the mask of the bytes
+    /// enclosed in double quotes (opening quotes included, closing quotes
+    /// excluded) when the block starts outside double quotes, escaped double
+    /// quotes ("") leaving the mask unchanged.
+    static std::uint64_t prefix_xor(std::uint64_t mask)
+    {
+        mask ^= mask << 1;
+        mask ^= mask << 2;
+        mask ^= mask << 4;
+        mask ^= mask << 8;
+        mask ^= mask << 16;
+        mask ^= mask << 32;
+        return mask;
+    }
+
+    /// Returns the mask of bits at positions greater than or equal to i, with
+    /// i lower than 64.
+    static std::uint64_t mask_from(size_t i) { return ~0ULL << i; }
+
+    /// Returns the index of the lowest set bit of a non-zero mask.
+    static size_t lowest_bit(std::uint64_t mask)
+    {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(mask));
+#else
+        size_t i = 0;
+        while(!(mask & 1)) {
+            mask >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+
+private:
+    /// Removes from chars the bytes of block detected by mistake by the
+    /// nibble-based classifier.
+    std::uint64_t filter_chars(const char *block, std::uint64_t chars) const
+    {
+        for(std::uint64_t bits = chars; bits; bits &= bits - 1) {
+            const size_t i = lowest_bit(bits);
+            if(!m_is_char[static_cast<unsigned char>(block[i])]) {
+                chars &= ~(1ULL << i);
+            }
+        }
+        return chars;
+    }
+
+    // Beyond this number of characters, one comparison per character costs
+    // more than classifying bytes one at a time.
+    static const size_t simd_chars_max = 8;
+
+    std::vector<char> m_chars;
+    bool m_is_char[256];
+    std::uint8_t m_low_nibbles[16];  // groups of the characters having each low nibble
+    std::uint8_t m_high_nibbles[16]; // groups of the characters having each high nibble
+    bool m_nibbles_exact {true};     // whether no byte is detected by mistake
+#if defined(CSV_BLOCK_SCANNER_AVX2)
+    bool m_use_avx2 {false};
+    bool m_use_ssse3 {false};
+#endif
+};
+
+#endif // CSV_BLOCK_SCANNER_H
@@ -0,0 +1,353 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_columnar_sink.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/// Returns whether the s_len characters of s match the given lowercase word,
+/// in any case.
+bool equals_ignoring_case(const char *s, size_t s_len, const char *word)
+{
+    size_t i = 0;
+    for(; i < s_len && word[i]; i++) {
+        const char c = (s[i] >= 'A' && s[i] <= 'Z') ? static_cast<char>(s[i] - 'A' + 'a') : s[i];
+        if(c != word[i]) {
+            return false;
+        }
+    }
+    return i == s_len && !word[i];
+}
+
+/// Parses [+-]?[0-9]+ into value. Returns false if s is not in that format or
+/// does not fit in 64 bits.
+bool parse_integer(const char *s, size_t s_len, std::int64_t &value)
+{
+    size_t i = 0;
+    const bool negative = s_len > 0 && s[0] == '-';
+    if(s_len > 0 && (s[0] == '-' || s[0] == '+')) {
+        i++;
+    }
+    if(i == s_len) {
+        return false;
+    }
+
+    const std::uint64_t limit = negative
+        ? static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1
+        : static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+    std::uint64_t magnitude = 0;
+    for(; i < s_len; i++) {
+        if(!is_digit(s[i])) {
+            return false;
+        }
+        const unsigned int digit = s[i] - '0';
+        if(magnitude > (limit - digit) / 10) {
+            return false;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+    value = negative ? static_cast<std::int64_t>(0 - magnitude) : static_cast<std::int64_t>(magnitude);
+    return true;
+}
+
+/// Parses [+-]?([0-9]+(\.[0-9]*)?|\.[0-9]+)([eE][+-]?[0-9]+)? into value.
+/// Returns false if s is not in that format or is out of range. The format
+/// is checked beforehand since strtod() also accepts other notations (e.g.
+/// hexadecimal numbers, infinity and leading spaces).
+bool parse_floating(const char *s, size_t s_len, double &value)
+{
+    size_t i = 0;
+    if(i < s_len && (s[i] == '-' || s[i] == '+')) {
+        i++;
+    }
+    size_t digits = 0;
+    for(; i < s_len && is_digit(s[i]); i++) {
+        digits++;
+    }
+    if(i < s_len && s[i] == '.') {
+        for(i++; i < s_len && is_digit(s[i]); i++) {
+            digits++;
+        }
+    }
+    if(digits == 0) {
+        return false;
+    }
+    if(i < s_len && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        if(i < s_len && (s[i] == '-' || s[i] == '+')) {
+            i++;
+        }
+        size_t exponent_digits = 0;
+        for(; i < s_len && is_digit(s[i]); i++) {
+            exponent_digits++;
+        }
+        if(exponent_digits == 0) {
+            return false;
+        }
+    }
+    if(i != s_len) {
+        return false;
+    }
+
+    // strtod() needs a null-terminated string.
+    char buffer[64];
+    std::string long_buffer;
+    const char *str = buffer;
+    if(s_len < sizeof(buffer)) {
+        std::copy(s, s + s_len, buffer);
+        buffer[s_len] = '\0';
+    }
+    else {
+        long_buffer.assign(s, s_len);
+        str = long_buffer.c_str();
+    }
+    value = std::strtod(str, nullptr);
+    return std::isfinite(value);
+}
+
+} // namespace
+
+std::string csv_columnar_sink::stats::descr() const
+{
+    std::ostringstream stream;
+    stream << rows << " rows, "
+           << batches << " batches ("
+           << early_batches << " passed early to widen a type), "
+           << mismatched_records << " records with a mismatched number of fields";
+    return stream.str();
+}
+
+csv_columnar_sink::csv_columnar_sink(const batch_callback &callback, const options &opts)
+    : m_callback(callback)
+    , m_options(opts)
+{
+    if(m_options.batch_rows == 0) {
+        m_options.batch_rows = options().batch_rows;
+    }
+}
+
+csv_columnar_sink::csv_columnar_sink(const batch_callback &callback)
+    : csv_columnar_sink(callback, options())
+{
+}
+
+void csv_columnar_sink::add_record(const csv_record &record)
+{
+    if(!m_columns_set) {
+        set_columns(record);
+        if(m_options.header) {
+            return;
+        }
+    }
+
+    std::vector<csv_column> &columns = m_batch.columns;
+    if(record.size() != columns.size()) {
+        m_stats.mismatched_records++;
+    }
+
+    // Parse the values first, so that the batch can be passed to the callback
+    // before appending any of them if a type must be widened.
+    m_values.resize(columns.size());
+    bool type_widened = false;
+    for(size_t i = 0; i < columns.size(); i++) {
+        typed_value &value = m_values[i];
+        if(i >= record.size() || record[i].size == 0) {
+            value = typed_value {csv_column_type::none, false, 0, 0};
+        }
+        else if(m_options.infer_types && columns[i].type != csv_column_type::string) {
+            value = parse_value(record[i]);
+        }
+        else {
+            value = typed_value {csv_column_type::string, false, 0, 0};
+        }
+        const csv_column_type type = columns[i].type;
+        if(type != csv_column_type::none && widen(type, value.type) != type) {
+            type_widened = true;
+        }
+    }
+    if(type_widened && m_batch.rows > 0) {
+        m_stats.early_batches++;
+        flush();
+    }
+
+    for(size_t i = 0; i < columns.size(); i++) {
+        csv_column &column = columns[i];
+        const csv_column_type type = widen(column.type, m_values[i].type);
+        if(type != column.type) {
+            set_type(column, type);
+        }
+        append(column, i < record.size() ? &record[i] : nullptr, m_values[i]);
+    }
+    m_batch.rows++;
+    m_stats.rows++;
+
+    if(m_batch.rows >= m_options.batch_rows) {
+        flush();
+    }
+}
+
+void csv_columnar_sink::flush()
+{
+    if(m_batch.rows == 0) {
+        return;
+    }
+    m_callback(m_batch);
+    m_stats.batches++;
+    clear_batch();
+}
+
+csv_parser::record_callback csv_columnar_sink::record_callback()
+{
+    return [this](const csv_record &record) { add_record(record); };
+}
+
+std::vector<csv_column_type> csv_columnar_sink::column_types() const
+{
+    std::vector<csv_column_type> types;
+    for(const csv_column &column : m_batch.columns) {
+        types.push_back(column.type);
+    }
+    return types;
+}
+
+const char* csv_columnar_sink::type_name(csv_column_type type)
+{
+    switch(type) {
+    case csv_column_type::none: return "none";
+    case csv_column_type::boolean: return "boolean";
+    case csv_column_type::integer: return "integer";
+    case csv_column_type::floating: return "floating";
+    case csv_column_type::string: return "string";
+    }
+    return "";
+}
+
+csv_columnar_sink::typed_value csv_columnar_sink::parse_value(const csv_field_view &field)
+{
+    typed_value value {csv_column_type::string, false, 0, 0};
+    if(field.size == 0) {
+        value.type = csv_column_type::none;
+    }
+    else if(equals_ignoring_case(field.data, field.size, "true")
+         || equals_ignoring_case(field.data, field.size, "false")) {
+        value.type = csv_column_type::boolean;
+        value.boolean = field.size == 4;
+    }
+    else if(parse_integer(field.data, field.size, value.integer)) {
+        value.type = csv_column_type::integer;
+        value.floating = static_cast<double>(value.integer);
+    }
+    else if(parse_floating(field.data, field.size, value.floating)) {
+        value.type = csv_column_type::floating;
+    }
+    return value;
+}
+
+csv_column_type csv_columnar_sink::widen(csv_column_type type, csv_column_type value_type)
+{
+    if(value_type == csv_column_type::none || value_type == type) {
+        return type;
+    }
+    if(type == csv_column_type::none) {
+        return value_type;
+    }
+    const bool numbers = (type == csv_column_type::integer || type == csv_column_type::floating)
+        && (value_type == csv_column_type::integer || value_type == csv_column_type::floating);
+    return numbers ? csv_column_type::floating : csv_column_type::string;
+}
+
+void csv_columnar_sink::set_columns(const csv_record &record)
+{
+    m_batch.columns.resize(record.size());
+    for(size_t i = 0; i < record.size(); i++) {
+        csv_column &column = m_batch.columns[i];
+        if(m_options.header) {
+            column.name = record[i].str();
+        }
+        set_type(column, m_options.infer_types ? csv_column_type::none : csv_column_type::string);
+    }
+    m_columns_set = true;
+}
+
+void csv_columnar_sink::set_type(csv_column &column, csv_column_type type)
+{
+    const size_t rows = column.size();
+    column.type = type;
+    column.booleans.assign(type == csv_column_type::boolean ? rows : 0, 0);
+    column.integers.assign(type == csv_column_type::integer ? rows : 0, 0);
+    column.floats.assign(type == csv_column_type::floating ? rows : 0, 0);
+    column.offsets.assign(type == csv_column_type::string ? rows + 1 : 0, 0);
+    column.data.clear();
+}
+
+void csv_columnar_sink::append(
+    csv_column &column,
+    const csv_field_view *field,
+    const typed_value &value
+)
+{
+    column.present.push_back(value.type != csv_column_type::none);
+    switch(column.type) {
+    case csv_column_type::none:
+        break;
+    case csv_column_type::boolean:
+        column.booleans.push_back(value.boolean);
+        break;
+    case csv_column_type::integer:
+        column.integers.push_back(value.integer);
+        break;
+    case csv_column_type::floating:
+        column.floats.push_back(value.floating);
+        break;
+    case csv_column_type::string:
+        if(field) {
+            column.data.append(field->data, field->size);
+        }
+        column.offsets.push_back(column.data.size());
+        break;
+    }
+}
+
+void csv_columnar_sink::clear_batch()
+{
+    m_batch.first_row += m_batch.rows;
+    m_batch.rows = 0;
+    for(csv_column &column : m_batch.columns) {
+        column.present.clear();
+        set_type(column, column.type);
+    }
+}
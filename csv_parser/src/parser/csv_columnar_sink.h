@@ -0,0 +1,172 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_COLUMNAR_SINK_H
+#define CSV_COLUMNAR_SINK_H
+
+#include "csv_parser.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Types inferred for the values of a column, from the narrowest to the
+/// widest. A column only has the none type while all its values are empty.
+enum class csv_column_type {
+    none,
+    boolean,  // true or false, in any case
+    integer,  // 64-bit signed integer in decimal notation
+    floating, // decimal number, possibly with an exponent
+    string,
+};
+
+/// Values of a column for the rows of a csv_batch. Only the array matching
+/// the column type is filled, with one value per row (false, 0 or an empty
+/// string for empty values); string values are stored back to back in data,
+/// value i being [offsets[i], offsets[i+1]).
+struct csv_column {
+    std::string name;
+    csv_column_type type {csv_column_type::none};
+    std::vector<std::uint8_t> present; // 0 for rows where the value is empty or missing
+    std::vector<std::uint8_t> booleans;
+    std::vector<std::int64_t> integers;
+    std::vector<double> floats;
+    std::vector<size_t> offsets;
+    std::string data;
+
+    size_t size() const { return present.size(); }
+
+    /// Returns the string value of a row (string columns only).
+    csv_field_view string_at(size_t row) const
+    { return csv_field_view(data.data() + offsets[row], offsets[row+1] - offsets[row]); }
+};
+
+/// Consecutive rows stored column by column.
+struct csv_batch {
+    std::vector<csv_column> columns;
+    std::uint64_t first_row {0}; // index of the first row of the batch among all rows
+    size_t rows {0};
+};
+
+/// Receives the records of a csv_parser (or csv_parallel_parser) and appends
+/// their fields directly to per-column buffers, instead of keeping records as
+/// arrays of strings. The first record is the header line (R3 & R4) naming the
+/// columns unless disabled, in which case the number of columns is the number
+/// of fields of the first record. Missing fields of shorter records are empty
+/// values, and extra fields of longer records are dropped.
+///
+/// Rows are passed to a callback in batches of a fixed maximum number of rows,
+/// so that memory usage remains bounded; buffers are reused from one batch to
+/// the next. When types are inferred, values are parsed into typed arrays as
+/// they are read and the type of a column only widens (integers become
+/// floating-point numbers, then any other mix becomes strings). Since typed
+/// values cannot be turned back into their text, a batch is passed to the
+/// callback as soon as a value requires a wider type, before the value is
+/// appended; all values of a column in a batch therefore have the same type,
+/// which may only be wider in later batches.
+class csv_columnar_sink
+{
+public:
+    struct options {
+        bool header {true};         // whether the first record names the columns
+        bool infer_types {true};    // whether types are inferred, or all columns are strings
+        size_t batch_rows {65536};  // maximum number of rows in a batch
+    };
+
+    /// Statistics about the rows added so far.
+    struct stats {
+        std::uint64_t rows {0};                // number of rows
+        std::uint64_t batches {0};             // number of batches passed to the callback
+        std::uint64_t early_batches {0};       // batches passed before being full to widen a type
+        std::uint64_t mismatched_records {0};  // rows whose number of fields differs from the number of columns
+
+        /// Convenient informative function.
+        std::string descr() const;
+    };
+
+    typedef std::function<void (const csv_batch &)> batch_callback;
+
+public:
+    explicit csv_columnar_sink(const batch_callback &callback,
+                               const options &opts);
+
+    /// Same as above using default options.
+    explicit csv_columnar_sink(const batch_callback &callback);
+
+    /// Adds a record as a row, or sets the column names if it is the header
+    /// line.
+    void add_record(const csv_record &record);
+
+    /// Passes the pending rows to the callback, if any. Must be called once
+    /// the end of input has been parsed.
+    void flush();
+
+    /// Returns a callback adding records to this sink, to give to a parser.
+    csv_parser::record_callback record_callback();
+
+    const options& get_options() const { return m_options; }
+
+    const stats& run_stats() const { return m_stats; }
+
+    /// Types of the columns, as of the last row added.
+    std::vector<csv_column_type> column_types() const;
+
+    static const char* type_name(csv_column_type type);
+
+private:
+    /// Value of a field parsed with the narrowest type it fits in.
+    struct typed_value {
+        csv_column_type type;
+        bool boolean;
+        std::int64_t integer;
+        double floating;
+    };
+
+    static typed_value parse_value(const csv_field_view &field);
+
+    static csv_column_type widen(csv_column_type type, csv_column_type value_type);
+
+    void set_columns(const csv_record &record);
+
+    /// Sets the type of a column, filling the array of that type for the rows
+    /// already in the batch (which all have empty values).
+    void set_type(csv_column &column, csv_column_type type);
+
+    void append(csv_column &column, const csv_field_view *field, const typed_value &value);
+
+    void clear_batch();
+
+private:
+    batch_callback m_callback;
+    options m_options;
+    stats m_stats;
+    csv_batch m_batch;
+    bool m_columns_set {false};
+    std::vector<typed_value> m_values; // values of the record being added
+};
+
+#endif // CSV_COLUMNAR_SINK_H
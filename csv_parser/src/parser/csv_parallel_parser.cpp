@@ -0,0 +1,489 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_parallel_parser.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CSV_PARALLEL_PARSER_MMAP
+#endif
+
+namespace {
+
+/// Returns the length of the next slice of input to give to a parser at
+/// offset pos of data, so that parsing stops soon after the end of a chunk:
+/// slices never cross the end of the chunk, and are small beyond it where
+/// only the end of a record is expected.
+size_t slice_length(std::uint64_t pos, std::uint64_t chunk_end, size_t size)
+{
+    const std::uint64_t slice_size_max = 256 * 1024;
+    const std::uint64_t tail_slice_size = 4 * 1024;
+    const std::uint64_t length = pos < chunk_end
+                               ? std::min(chunk_end - pos, slice_size_max)
+                               : tail_slice_size;
+    return static_cast<size_t>(std::min<std::uint64_t>(length, size - pos));
+}
+
+/// Records kept until they can be passed to the callback in input order.
+/// Field values pointing to the input are kept as is, the others (i.e. values
+/// copied by the parser) are copied.
+class record_store
+{
+public:
+    void add(const csv_record &record,
+             const char *input_begin,
+             const char *input_end)
+    {
+        record_info info;
+        info.first_field = m_fields.size();
+        info.field_count = record.size();
+        info.first_warning = m_warnings.size();
+        info.warning_count = record.warnings.size();
+        info.begin_offset = record.begin_offset;
+        info.end_offset = record.end_offset;
+        m_records.push_back(info);
+
+        for(const csv_field_view &field : record.fields) {
+            stored_field stored {field.data, 0, field.size};
+            if(field.data < input_begin || field.data + field.size > input_end) {
+                stored.data = nullptr;
+                stored.offset = m_data.size();
+                m_data.append(field.data, field.size);
+            }
+            m_fields.push_back(stored);
+        }
+        m_warnings.insert(m_warnings.end(), record.warnings.begin(), record.warnings.end());
+    }
+
+    size_t size() const { return m_records.size(); }
+
+    std::uint64_t end_offset(size_t i) const { return m_records[i].end_offset; }
+
+    /// Keeps the first count records.
+    void truncate(size_t count)
+    {
+        if(count < m_records.size()) {
+            m_fields.resize(m_records[count].first_field);
+            m_warnings.resize(m_records[count].first_warning);
+            m_records.resize(count);
+        }
+    }
+
+    /// Sets first to the index of the first record following the record
+    /// boundary at offset, if this boundary is known. The first record is
+    /// only considered to start at a record boundary if exact_begin is true.
+    bool find_start(std::uint64_t offset, bool exact_begin, size_t &first) const
+    {
+        if(exact_begin && !m_records.empty() && m_records[0].begin_offset == offset) {
+            first = 0;
+            return true;
+        }
+        const auto it = std::lower_bound(
+            m_records.begin(), m_records.end(), offset,
+            [](const record_info &info, std::uint64_t value) {
+                return info.end_offset < value;
+            }
+        );
+        if(it == m_records.end() || it->end_offset != offset) {
+            return false;
+        }
+        first = (it - m_records.begin()) + 1;
+        return true;
+    }
+
+    /// Sets record to the record at index i, except for its index.
+    void get(size_t i, csv_record &record) const
+    {
+        const record_info &info = m_records[i];
+        record.fields.clear();
+        for(size_t f = info.first_field; f < info.first_field + info.field_count; f++) {
+            const stored_field &stored = m_fields[f];
+            record.fields.push_back(csv_field_view(
+                stored.data ? stored.data : m_data.data() + stored.offset,
+                stored.size
+            ));
+        }
+        record.warnings.assign(m_warnings.begin() + info.first_warning,
+                               m_warnings.begin() + info.first_warning + info.warning_count);
+        record.begin_offset = info.begin_offset;
+        record.end_offset = info.end_offset;
+    }
+
+private:
+    struct stored_field {
+        const char *data; // field value in input, or nullptr if copied in m_data
+        size_t offset;    // offset of the copied field value in m_data
+        size_t size;
+    };
+
+    struct record_info {
+        size_t first_field;
+        size_t field_count;
+        size_t first_warning;
+        size_t warning_count;
+        std::uint64_t begin_offset;
+        std::uint64_t end_offset;
+    };
+
+    std::string m_data;
+    std::vector<stored_field> m_fields;
+    std::vector<csv_warning> m_warnings;
+    std::vector<record_info> m_records;
+};
+
+#if defined(CSV_PARALLEL_PARSER_MMAP)
+/// Read-only memory mapping of a whole file.
+class mapped_file
+{
+public:
+    explicit mapped_file() {}
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file& operator=(const mapped_file &) = delete;
+
+    ~mapped_file()
+    {
+        if(m_data && m_size > 0) {
+            munmap(m_data, m_size);
+        }
+    }
+
+    /// Returns false and sets errno on failure.
+    bool map(const std::string &filename)
+    {
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if(fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if(fstat(fd, &st) != 0) {
+            const int error_code = errno;
+            close(fd);
+            errno = error_code;
+            return false;
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        if(m_size > 0) {
+            m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(m_data == MAP_FAILED) {
+                const int error_code = errno;
+                m_data = nullptr;
+                close(fd);
+                errno = error_code;
+                return false;
+            }
+            madvise(m_data, m_size, MADV_SEQUENTIAL);
+        }
+        close(fd);
+        return true;
+    }
+
+    const char* data() const { return static_cast<const char *>(m_data); }
+    size_t size() const { return m_size; }
+
+private:
+    void *m_data {nullptr};
+    size_t m_size {0};
+};
+#endif
+
+} // namespace
+
+/// Records found in a chunk.
+struct csv_parallel_parser::chunk_result {
+    record_store outside;          // records of the parse starting outside double quotes
+    record_store inside;           // records of the parse starting inside double quotes
+    bool converged {false};        // whether both parses reached a common record boundary
+    std::uint64_t convergence {0}; // that record boundary, after which inside holds no record
+};
+
+std::string csv_parallel_parser::stats::descr() const
+{
+    std::ostringstream stream;
+    stream << chunks << " chunks, "
+           << inside_quotes << " resolved inside double quotes, "
+           << reparsed << " reparsed";
+    return stream.str();
+}
+
+csv_parallel_parser::csv_parallel_parser(const options &opts)
+    : m_options(opts)
+{
+    if(m_options.threads == 0) {
+        m_options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(m_options.chunk_size == 0) {
+        m_options.chunk_size = options().chunk_size;
+    }
+}
+
+void csv_parallel_parser::parse(
+    const char *data,
+    size_t size,
+    const csv_parser::record_callback &callback
+)
+{
+    m_stats = stats();
+
+    const std::uint64_t chunk_size = m_options.chunk_size;
+    const unsigned int threads = m_options.threads;
+    std::vector<chunk_result> results(threads);
+    csv_record record;
+    std::uint64_t record_index = 0;
+    std::uint64_t boundary = 0; // end offset of the last record passed to callback
+
+    auto emit = [&](const record_store &store, size_t first) {
+        for(size_t i = first; i < store.size(); i++) {
+            store.get(i, record);
+            record.index = record_index++;
+            callback(record);
+            boundary = store.end_offset(i);
+        }
+    };
+
+    for(std::uint64_t round_begin = 0; round_begin < size && boundary < size;
+        round_begin += threads * chunk_size) {
+        const unsigned int chunk_count = static_cast<unsigned int>(std::min<std::uint64_t>(
+            threads, (size - round_begin + chunk_size - 1) / chunk_size));
+        auto chunk_begin = [&](unsigned int c) { return round_begin + c * chunk_size; };
+        auto chunk_end = [&](unsigned int c) {
+            return std::min<std::uint64_t>(size, chunk_begin(c) + chunk_size);
+        };
+
+        // Parse the chunks of the round speculatively, except the first one
+        // which starts at or before the end of the last record passed to
+        // callback.
+        std::vector<std::thread> workers;
+        for(unsigned int c = 1; c < chunk_count; c++) {
+            workers.emplace_back([&, c]() {
+                parse_chunk(data, size, chunk_begin(c), chunk_end(c), results[c]);
+            });
+        }
+        m_stats.chunks += chunk_count;
+        if(boundary < chunk_end(0)) {
+            boundary = parse_exact(data, size, boundary, chunk_end(0), record_index, callback);
+        }
+        for(std::thread &worker : workers) {
+            worker.join();
+        }
+
+        // Pass the records of the other chunks to callback in order.
+        for(unsigned int c = 1; c < chunk_count; c++) {
+            if(boundary >= chunk_end(c)) {
+                continue; // the chunk is part of the last record passed to callback
+            }
+
+            const chunk_result &result = results[c];
+            size_t first = 0;
+            if(result.outside.find_start(boundary, boundary == chunk_begin(c), first)) {
+                emit(result.outside, first);
+            }
+            else if(result.inside.find_start(boundary, false, first)) {
+                m_stats.inside_quotes++;
+                emit(result.inside, first);
+                if(result.converged && result.outside.find_start(result.convergence, false, first)) {
+                    emit(result.outside, first);
+                }
+            }
+            if(boundary < chunk_end(c)) {
+                m_stats.reparsed++;
+                boundary = parse_exact(data, size, boundary, chunk_end(c), record_index, callback);
+            }
+        }
+    }
+}
+
+bool csv_parallel_parser::parse_file(
+    const std::string &filename,
+    const csv_parser::record_callback &callback
+)
+{
+    m_error.clear();
+
+#if defined(CSV_PARALLEL_PARSER_MMAP)
+    mapped_file file;
+    if(!file.map(filename)) {
+        m_error = "cannot map " + filename + ": " + std::strerror(errno);
+        return false;
+    }
+    parse(file.data(), file.size(), callback);
+#else
+    std::ifstream file(filename, std::ios::binary);
+    if(!file.is_open()) {
+        m_error = "cannot open " + filename;
+        return false;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    const std::string &data = content.str();
+    parse(data.data(), data.size(), callback);
+#endif
+    return true;
+}
+
+std::uint64_t csv_parallel_parser::parse_exact(
+    const char *data,
+    size_t size,
+    std::uint64_t begin,
+    std::uint64_t end,
+    std::uint64_t &record_index,
+    const csv_parser::record_callback &callback
+) const
+{
+    std::uint64_t boundary = begin;
+    bool done = begin >= end;
+    csv_parser parser(
+        [&](const csv_record &record) {
+            if(!done) {
+                callback(record);
+                record_index = record.index + 1;
+                boundary = record.end_offset;
+                done = boundary >= end;
+            }
+        },
+        m_options.parser
+    );
+    parser.reset(begin, record_index);
+
+    for(std::uint64_t pos = begin; !done; ) {
+        const size_t slice = slice_length(pos, end, size);
+        parser.parse(data + pos, slice);
+        pos += slice;
+        if(pos == size) {
+            parser.end();
+            done = true;
+        }
+    }
+    return boundary;
+}
+
+void csv_parallel_parser::parse_chunk(
+    const char *data,
+    size_t size,
+    std::uint64_t begin,
+    std::uint64_t end,
+    chunk_result &result
+) const
+{
+    struct hypothesis {
+        record_store *records;
+        bool done;
+    };
+
+    result = chunk_result();
+    if(begin >= end) {
+        return;
+    }
+
+    auto make_parser = [&](hypothesis &h) {
+        return std::unique_ptr<csv_parser>(new csv_parser(
+            [&h, data, size, end](const csv_record &record) {
+                if(!h.done) {
+                    h.records->add(record, data, data + size);
+                    h.done = record.end_offset >= end;
+                }
+            },
+            m_options.parser
+        ));
+    };
+
+    // The parse starting inside double quotes reads a double quote located
+    // just before the chunk to enter q2.
+    hypothesis outside {&result.outside, false};
+    hypothesis inside {&result.inside, false};
+    std::unique_ptr<csv_parser> outside_parser = make_parser(outside);
+    std::unique_ptr<csv_parser> inside_parser = make_parser(inside);
+    outside_parser->reset(begin, 0);
+    inside_parser->reset(begin - 1, 0);
+    inside_parser->parse("\"", 1);
+
+    size_t outside_checked = 0;
+    size_t inside_checked = 0;
+    for(std::uint64_t pos = begin; !outside.done || !inside.done; ) {
+        const size_t slice = slice_length(pos, end, size);
+        const bool outside_active = !outside.done;
+        const bool inside_active = !inside.done;
+        if(outside_active) {
+            outside_parser->parse(data + pos, slice);
+        }
+        if(inside_active) {
+            inside_parser->parse(data + pos, slice);
+        }
+        pos += slice;
+        if(pos == size) {
+            if(outside_active) {
+                outside_parser->end();
+                outside.done = true;
+            }
+            if(inside_active) {
+                inside_parser->end();
+                inside.done = true;
+            }
+        }
+        else if(pos >= end) {
+            // Without double quotes after the chunk, the parse starting
+            // inside double quotes could read the rest of input as a single
+            // field: it is not carried on beyond the chunk, the records it
+            // misses being parsed again if needed.
+            inside.done = true;
+        }
+
+        // Once both parses end a record at the same offset, they continue
+        // identically.
+        if(!result.converged) {
+            while(outside_checked < result.outside.size() && inside_checked < result.inside.size()) {
+                const std::uint64_t outside_end = result.outside.end_offset(outside_checked);
+                const std::uint64_t inside_end = result.inside.end_offset(inside_checked);
+                if(outside_end == inside_end) {
+                    result.inside.truncate(inside_checked + 1);
+                    result.converged = true;
+                    result.convergence = inside_end;
+                    inside.done = true;
+                    break;
+                }
+                if(outside_end < inside_end) {
+                    outside_checked++;
+                }
+                else {
+                    inside_checked++;
+                }
+            }
+        }
+    }
+}
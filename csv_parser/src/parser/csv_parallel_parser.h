@@ -0,0 +1,117 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_PARALLEL_PARSER_H
+#define CSV_PARALLEL_PARSER_H
+
+#include "csv_parser.h"
+
+#include <cstdint>
+#include <string>
+
+/// Parses a whole input held in memory, such as a memory-mapped file, using
+/// several threads, and passes records to a callback in input order with the
+/// same field values, warnings and offsets as csv_parser.
+///
+/// Input is split into chunks parsed by one thread each, in rounds of as many
+/// chunks as threads so that memory usage remains bounded. Records cannot be
+/// found by splitting input at line separators since these may be enclosed in
+/// double quotes (R6), so the state of the state machine at the beginning of a
+/// chunk is unknown until the previous chunks have been parsed. Each chunk is
+/// therefore parsed speculatively twice, starting outside and inside double
+/// quotes, the second parse being abandoned as soon as both reach the same
+/// record boundary. Once the previous chunk has been stitched, the actual end
+/// of its last record is known; it is searched among the record boundaries
+/// found by either parse, the records following it being exact. The chunk is
+/// parsed again from the last record boundary known in the rare case neither
+/// parse covers it until its end. The first chunk of a round always starts at
+/// a known record boundary and is parsed directly by the calling thread.
+class csv_parallel_parser
+{
+public:
+    struct options {
+        csv_parser::options parser;     // options of the underlying parsers
+        unsigned int threads {0};       // number of threads (0 means one per hardware thread)
+        size_t chunk_size {4 << 20};    // size of the chunk parsed by each thread in a round
+    };
+
+    /// Statistics about the last parse.
+    struct stats {
+        std::uint64_t chunks {0};          // number of chunks
+        std::uint64_t inside_quotes {0};   // chunks whose records came from the parse starting inside double quotes
+        std::uint64_t reparsed {0};        // chunks (partly) parsed again since neither speculative parse reached their end
+
+        /// Convenient informative function.
+        std::string descr() const;
+    };
+
+public:
+    explicit csv_parallel_parser(const options &opts);
+
+    /// Parses size bytes of data followed by the End Of File Signal, and
+    /// passes records to callback from the calling thread.
+    void parse(const char *data,
+               size_t size,
+               const csv_parser::record_callback &callback);
+
+    /// Same as above for the content of a file, which is memory-mapped when
+    /// possible. Returns false if the file cannot be read, in which case
+    /// error() describes the reason.
+    bool parse_file(const std::string &filename,
+                    const csv_parser::record_callback &callback);
+
+    const stats& run_stats() const { return m_stats; }
+
+    const std::string& error() const { return m_error; }
+
+private:
+    struct chunk_result;
+
+    /// Parses the chunk of data starting at the record boundary begin, passing
+    /// records to callback until the first one ending at or after end. The
+    /// first record has the given index, which is updated to the index of the
+    /// next record. Returns the end offset of the last record passed.
+    std::uint64_t parse_exact(const char *data,
+                              size_t size,
+                              std::uint64_t begin,
+                              std::uint64_t end,
+                              std::uint64_t &record_index,
+                              const csv_parser::record_callback &callback) const;
+
+    /// Parses the chunk [begin, end) of data under both hypotheses.
+    void parse_chunk(const char *data,
+                     size_t size,
+                     std::uint64_t begin,
+                     std::uint64_t end,
+                     chunk_result &result) const;
+
+private:
+    options m_options;
+    stats m_stats;
+    std::string m_error;
+};
+
+#endif // CSV_PARALLEL_PARSER_H
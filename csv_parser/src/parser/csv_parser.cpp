@@ -0,0 +1,471 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_parser.h"
+
+#include <algorithm>
+#include <cstring>
+
+std::vector<std::string> csv_record::strings() const
+{
+    std::vector<std::string> out;
+    out.reserve(fields.size());
+    for(const csv_field_view &field : fields) {
+        out.push_back(field.str());
+    }
+    return out;
+}
+
+csv_parser::csv_parser(const record_callback &callback, const options &opts)
+    : m_callback(callback)
+    , m_options(opts)
+    , m_separators(opts.field_separators, opts.line_separators)
+    , m_scanner(m_separators.first_chars())
+{
+    reset();
+}
+
+csv_parser::csv_parser(const record_callback &callback)
+    : csv_parser(callback, options())
+{
+}
+
+void csv_parser::parse(const char *data, size_t size)
+{
+    std::uint64_t offset = m_input_size;
+    m_input_size += size;
+
+    if(!m_held.empty()) {
+        // Parse the held bytes followed by enough bytes of the chunk to
+        // recognize any separator starting in the held bytes.
+        const size_t held_size = m_held.size();
+        m_stitch.assign(m_held);
+        m_stitch.append(data, std::min(size, 2 * m_separators.length_max()));
+        m_held.clear();
+
+        set_buffer(m_stitch.data(), m_stitch.size(), offset - held_size);
+        const size_t pos = process(0, held_size, false);
+        if(pos < held_size) {
+            // Still undecided: the chunk has been appended entirely.
+            m_held.assign(m_stitch, pos, std::string::npos);
+            release_buffer(pos);
+            return;
+        }
+        release_buffer(pos);
+
+        const size_t consumed = pos - held_size;
+        data += consumed;
+        size -= consumed;
+        offset += consumed;
+    }
+
+    set_buffer(data, size, offset);
+    const size_t pos = process(0, size, false);
+    m_held.assign(data + pos, size - pos);
+    release_buffer(pos);
+}
+
+void csv_parser::end()
+{
+    if(!m_held.empty()) {
+        m_stitch.swap(m_held);
+        m_held.clear();
+        set_buffer(m_stitch.data(), m_stitch.size(), m_input_size - m_stitch.size());
+        release_buffer(process(0, m_stitch.size(), true));
+    }
+    set_buffer("", 0, m_input_size);
+
+    // End Of File Signal.
+    switch(m_state) {
+    case state::q0:
+        if(m_record_started) {
+            finish_field(0); // empty field after a field separator
+            emit_record(m_input_size);
+        }
+        break;
+    case state::q1:
+    case state::q3:
+        finish_field(0); // the field value is held in m_field_copy
+        emit_record(m_input_size);
+        break;
+    case state::q2:
+        m_record.warnings.push_back({csv_warning_type::missing_end_quote, m_fields.size()});
+        finish_field(0);
+        emit_record(m_input_size);
+        break;
+    }
+    m_state = state::q0;
+}
+
+void csv_parser::reset()
+{
+    m_buf = nullptr;
+    m_buf_size = 0;
+    m_buf_offset = 0;
+    m_input_size = 0;
+    m_held.clear();
+    m_state = state::q0;
+    m_record_started = false;
+    m_run_start = 0;
+    m_quote_pos = 0;
+    m_quote_in_prev_buffer = false;
+    m_field_in_copy = false;
+    m_field_copy.clear();
+    m_fields.clear();
+    m_arena.clear();
+    m_record.fields.clear();
+    m_record.warnings.clear();
+    m_record.index = 0;
+}
+
+void csv_parser::reset(std::uint64_t offset, std::uint64_t record_index)
+{
+    reset();
+    m_buf_offset = offset;
+    m_input_size = offset;
+    m_record.index = record_index;
+}
+
+size_t csv_parser::process(size_t pos, size_t stop_at, bool final)
+{
+    if(m_options.simd_scan) {
+        pos = scan_blocks(pos, stop_at, final);
+    }
+
+    // Scalar version, also used for the bytes left by scan_blocks().
+    const char *buf = m_buf;
+    const size_t size = m_buf_size;
+    while(pos < stop_at) {
+        switch(m_state) {
+        case state::q0:
+            if(!read_field_start(pos, final)) {
+                return pos;
+            }
+            break;
+
+        case state::q1:
+            while(pos < size && !m_separators.is_first_char(buf[pos])) {
+                pos++;
+            }
+            if(pos == size || !read_separator_candidate(pos, final)) {
+                return pos;
+            }
+            break;
+
+        case state::q2: {
+            const void *quote = std::memchr(buf + pos, '"', size - pos);
+            if(!quote) {
+                return size;
+            }
+            pos = static_cast<const char *>(quote) - buf;
+            read_quote(pos);
+            break;
+        }
+
+        case state::q3:
+            if(!read_after_quote(pos, final)) {
+                return pos;
+            }
+            break;
+        }
+    }
+    return pos;
+}
+
+size_t csv_parser::scan_blocks(size_t pos, size_t stop_at, bool final)
+{
+    // Each block is classified at once, and the state machine then jumps from
+    // one structural character to the next: double quotes, and the first
+    // characters of separators not enclosed in double quotes. The bytes
+    // enclosed in double quotes are found using a prefix XOR of the mask of
+    // double quotes, starting from the current state of the state machine.
+    // Double quotes not behaving as the prefix XOR assumes, i.e. read in q1
+    // or resulting in W_2, only require the mask to be recomputed from the
+    // following byte.
+
+    const char *buf = m_buf;
+    const size_t block_size = csv_block_scanner::block_size;
+    std::uint64_t quotes;
+    std::uint64_t chars;
+
+    auto structural_mask = [&](size_t from) {
+        const std::uint64_t carry = m_state == state::q2 ? ~0ULL : 0;
+        const std::uint64_t in_quotes = carry ^ csv_block_scanner::prefix_xor(
+            quotes & csv_block_scanner::mask_from(from));
+        return quotes | (chars & ~in_quotes);
+    };
+
+    while(pos < stop_at && m_buf_size - pos >= block_size) {
+        const size_t block_begin = pos;
+        const size_t block_end = pos + block_size;
+        m_scanner.classify(buf + block_begin, quotes, chars);
+        std::uint64_t structural = structural_mask(0);
+
+        while(pos < block_end && pos < stop_at) {
+            switch(m_state) {
+            case state::q0:
+                if(!read_field_start(pos, final)) {
+                    return pos;
+                }
+                break;
+
+            case state::q3:
+                if(!read_after_quote(pos, final)) {
+                    return pos;
+                }
+                if(m_state == state::q2 && buf[pos-1] != '"' && pos < block_end) {
+                    structural = structural_mask(pos - block_begin); // W_2
+                }
+                break;
+
+            case state::q1:
+            case state::q2: {
+                const std::uint64_t bits = structural
+                                         & csv_block_scanner::mask_from(pos - block_begin);
+                if(!bits) {
+                    pos = block_end;
+                    break;
+                }
+                pos = block_begin + csv_block_scanner::lowest_bit(bits);
+                if(buf[pos] != '"') {
+                    if(!read_separator_candidate(pos, final)) {
+                        return pos;
+                    }
+                }
+                else if(m_state == state::q2) {
+                    read_quote(pos);
+                }
+                else {
+                    pos++; // double quote kept as is in q1
+                    if(pos < block_end) {
+                        structural = structural_mask(pos - block_begin);
+                    }
+                }
+                break;
+            }
+            }
+        }
+    }
+    return pos;
+}
+
+bool csv_parser::read_field_start(size_t &pos, bool final)
+{
+    if(!m_record_started) {
+        start_record(pos);
+    }
+    if(m_separators.is_first_char(m_buf[pos])) {
+        size_t length;
+        const separator_kind kind = match_separator(pos, final, length);
+        if(kind == separator_kind::undecided) {
+            return false;
+        }
+        if(kind != separator_kind::none) {
+            on_separator(kind, pos, length);
+            pos += length;
+            return true;
+        }
+    }
+    if(m_buf[pos] == '"') {
+        m_state = state::q2;
+        m_run_start = pos + 1;
+    }
+    else {
+        m_state = state::q1;
+        m_run_start = pos;
+    }
+    pos++;
+    return true;
+}
+
+bool csv_parser::read_separator_candidate(size_t &pos, bool final)
+{
+    size_t length;
+    const separator_kind kind = match_separator(pos, final, length);
+    if(kind == separator_kind::undecided) {
+        return false;
+    }
+    if(kind == separator_kind::none) {
+        pos++;
+        return true;
+    }
+    on_separator(kind, pos, length);
+    pos += length;
+    return true;
+}
+
+void csv_parser::read_quote(size_t &pos)
+{
+    m_quote_pos = pos;
+    m_quote_in_prev_buffer = false;
+    m_state = state::q3;
+    pos++;
+}
+
+bool csv_parser::read_after_quote(size_t &pos, bool final)
+{
+    if(m_separators.is_first_char(m_buf[pos])) {
+        size_t length;
+        const separator_kind kind = match_separator(pos, final, length);
+        if(kind == separator_kind::undecided) {
+            return false;
+        }
+        if(kind != separator_kind::none) {
+            on_separator(kind, pos, length);
+            pos += length;
+            return true;
+        }
+    }
+    if(m_buf[pos] == '"') {
+        // Escaped double quote: keep one of both.
+        if(m_quote_in_prev_buffer) {
+            m_field_copy += '"';
+        }
+        else {
+            m_field_copy.append(m_buf + m_run_start, m_quote_pos + 1 - m_run_start);
+        }
+        m_field_in_copy = true;
+        m_run_start = pos + 1;
+    }
+    else {
+        // W_2: the double quote is kept as is.
+        m_record.warnings.push_back({csv_warning_type::quote_not_escaped, m_fields.size()});
+        if(m_quote_in_prev_buffer) {
+            m_field_copy += '"';
+            m_run_start = pos;
+        }
+    }
+    m_quote_in_prev_buffer = false;
+    m_state = state::q2;
+    pos++;
+    return true;
+}
+
+csv_parser::separator_kind csv_parser::match_separator(
+    size_t pos,
+    bool final,
+    size_t &length
+) const
+{
+    return m_separators.match(m_buf + pos, m_buf_size - pos, final, length);
+}
+
+void csv_parser::on_separator(separator_kind kind, size_t pos, size_t length)
+{
+    switch(m_state) {
+    case state::q0:
+        m_run_start = pos;
+        finish_field(pos); // empty field
+        break;
+    case state::q1:
+        finish_field(pos);
+        break;
+    case state::q3:
+        finish_field(m_quote_in_prev_buffer ? m_run_start : m_quote_pos);
+        break;
+    case state::q2:
+        break; // separators are not special in q2
+    }
+    m_state = state::q0;
+
+    if(kind == separator_kind::line) {
+        emit_record(m_buf_offset + pos + length);
+    }
+}
+
+void csv_parser::finish_field(size_t content_end)
+{
+    if(m_field_in_copy) {
+        m_field_copy.append(m_buf + m_run_start, content_end - m_run_start);
+        m_fields.push_back({true, m_arena.size(), m_field_copy.size()});
+        m_arena += m_field_copy;
+        m_field_copy.clear();
+        m_field_in_copy = false;
+    }
+    else {
+        m_fields.push_back({false, m_run_start, content_end - m_run_start});
+    }
+}
+
+void csv_parser::start_record(size_t pos)
+{
+    m_record_started = true;
+    m_record.begin_offset = m_buf_offset + pos;
+}
+
+void csv_parser::emit_record(std::uint64_t end_offset)
+{
+    m_record.fields.clear();
+    for(const field_ref &ref : m_fields) {
+        const char *data = ref.in_arena ? m_arena.data() : m_buf;
+        m_record.fields.push_back({data + ref.offset, ref.size});
+    }
+    m_record.end_offset = end_offset;
+    m_callback(m_record);
+
+    m_record.index++;
+    m_record.warnings.clear();
+    m_fields.clear();
+    m_arena.clear();
+    m_record_started = false;
+}
+
+void csv_parser::release_buffer(size_t pos)
+{
+    for(field_ref &ref : m_fields) {
+        if(!ref.in_arena) {
+            const size_t offset = m_arena.size();
+            m_arena.append(m_buf + ref.offset, ref.size);
+            ref.in_arena = true;
+            ref.offset = offset;
+        }
+    }
+
+    switch(m_state) {
+    case state::q0:
+        break;
+    case state::q1:
+    case state::q2:
+        m_field_copy.append(m_buf + m_run_start, pos - m_run_start);
+        m_field_in_copy = true;
+        break;
+    case state::q3:
+        if(!m_quote_in_prev_buffer) {
+            m_field_copy.append(m_buf + m_run_start, m_quote_pos - m_run_start);
+            m_quote_in_prev_buffer = true;
+        }
+        m_field_in_copy = true;
+        break;
+    }
+    m_run_start = 0;
+}
+
+void csv_parser::set_buffer(const char *data, size_t size, std::uint64_t offset)
+{
+    m_buf = data;
+    m_buf_size = size;
+    m_buf_offset = offset;
+}
@@ -0,0 +1,244 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_PARSER_H
+#define CSV_PARSER_H
+
+#include "csv_block_scanner.hpp"
+#include "csv_separator_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// View of a field value. The data is owned by the parser, or by the caller
+/// for fields read in a single chunk without transformation (zero-copy), and
+/// is only valid during the record callback.
+struct csv_field_view {
+    const char *data {nullptr};
+    size_t size {0};
+
+    csv_field_view() {}
+    csv_field_view(const char *data, size_t size) : data(data), size(size) {}
+
+    std::string str() const { return std::string(data, size); }
+
+    bool operator==(const std::string &s) const
+    { return s.size() == size && s.compare(0, size, data, size) == 0; }
+
+    bool operator!=(const std::string &s) const { return !(*this == s); }
+};
+
+/// Warnings generated on specific transitions of the state machine (see
+/// design_and_implementation_of_a_streaming_csv_parser.md).
+enum class csv_warning_type {
+    missing_end_quote, // W_1: quoted field invalid (missing end quote)
+    quote_not_escaped, // W_2: quoted field invalid (quote not escaped)
+};
+
+struct csv_warning {
+    csv_warning_type type;
+    size_t field_index; // index of the field concerned in its record
+};
+
+/// A record, i.e. the fields read from a line.
+struct csv_record {
+    std::vector<csv_field_view> fields;
+    std::vector<csv_warning> warnings;
+    std::uint64_t index {0};        // index of the record in input
+    std::uint64_t begin_offset {0}; // offset of the first byte of the record in input
+    std::uint64_t end_offset {0};   // offset past the line separator ending the record, if any
+
+    size_t size() const { return fields.size(); }
+    const csv_field_view& operator[](size_t i) const { return fields[i]; }
+
+    /// Returns copies of the field values.
+    std::vector<std::string> strings() const;
+};
+
+/// Streaming CSV parser compliant with RFC 4180, implementing the finite state
+/// machine documented in design_and_implementation_of_a_streaming_csv_parser.md:
+///     q0: start of field.
+///     q1: inside a field not enclosed in double quotes.
+///     q2: inside a field enclosed in double quotes.
+///     q3: double quote read in q2, either closing the field or escaping
+///         another double quote.
+///
+/// Input is given in chunks of any size through parse(), and end() signals the
+/// end of input (EOFS). Records are passed to a callback as soon as they are
+/// complete. Field values of records read in a single chunk point directly to
+/// the chunk, unless they contain escaped double quotes; values are only
+/// copied when they span several chunks or need unescaping.
+///
+/// Field values are the characters read after the opening double quote for
+/// fields enclosed in double quotes, escaped double quotes being unescaped.
+/// Invalid fields are reported by warnings: an unescaped double quote (W_2)
+/// is kept as is, and a field missing its closing double quote (W_1) extends
+/// to the end of input.
+class csv_parser
+{
+public:
+    struct options {
+        /// Strings separating fields. Several separators are allowed, the
+        /// longest one being used when several match.
+        std::vector<std::string> field_separators {","};
+
+        /// Strings separating lines, same as above.
+        std::vector<std::string> line_separators {"\r\n", "\n", "\r"};
+
+        /// Whether input is classified in blocks of bytes (see
+        /// csv_block_scanner) so as to jump from one double quote or separator
+        /// to the next, instead of stepping through the state machine one byte
+        /// at a time. Both methods produce the same records and warnings.
+        bool simd_scan {true};
+    };
+
+    typedef std::function<void (const csv_record &)> record_callback;
+
+public:
+    /// Throws std::invalid_argument if a separator is empty, contains a double
+    /// quote, or is both a field and a line separator.
+    explicit csv_parser(const record_callback &callback,
+                        const options &opts);
+
+    /// Same as above using default options.
+    explicit csv_parser(const record_callback &callback);
+
+    /// Parses a chunk of input. The chunk is only used during the call.
+    void parse(const char *data, size_t size);
+
+    void parse(const std::string &data) { parse(data.data(), data.size()); }
+
+    /// Signals the end of input (EOFS), passing the last record to the
+    /// callback if any. Input parsed afterwards starts a new line, records and
+    /// offsets still being counted from the beginning of input.
+    void end();
+
+    /// Discards any partially parsed input and restarts counting records and
+    /// offsets.
+    void reset();
+
+    /// Same as above for input resuming a larger input at the given offset,
+    /// where the record with the given index begins: offsets and indexes of
+    /// the following records are those in the larger input.
+    void reset(std::uint64_t offset, std::uint64_t record_index);
+
+    const options& get_options() const { return m_options; }
+
+    /// Number of records passed to the callback so far (or index of the next
+    /// record if reset() was given a record index).
+    std::uint64_t record_count() const { return m_record.index; }
+
+private:
+    enum class state { q0, q1, q2, q3 };
+
+    typedef csv_separator_set::kind separator_kind;
+
+    /// Location of a field value, either in the current buffer or in the
+    /// arena.
+    struct field_ref {
+        bool in_arena;
+        size_t offset;
+        size_t size;
+    };
+
+    /// Parses m_buf from pos until the first position reached at or after
+    /// stop_at between two tokens, and returns that position. A position lower
+    /// than stop_at is returned when a separator cannot be recognized without
+    /// reading further input, unless final is true.
+    size_t process(size_t pos, size_t stop_at, bool final);
+
+    /// Same as process() using csv_block_scanner, but only parses whole
+    /// blocks: the position returned may leave less than a block to parse.
+    size_t scan_blocks(size_t pos, size_t stop_at, bool final);
+
+    /// Reads the byte at pos in q0, or the separator starting there, and
+    /// advances pos. Returns false without doing anything if the separator is
+    /// undecided.
+    bool read_field_start(size_t &pos, bool final);
+
+    /// Same as above in q1 for a byte which might start a separator.
+    bool read_separator_candidate(size_t &pos, bool final);
+
+    /// Same as above in q2 for a double quote.
+    void read_quote(size_t &pos);
+
+    /// Same as above in q3.
+    bool read_after_quote(size_t &pos, bool final);
+
+    /// Returns the kind of the longest separator at pos in m_buf and sets
+    /// length to its length.
+    separator_kind match_separator(size_t pos, bool final, size_t &length) const;
+
+    void on_separator(separator_kind kind, size_t pos, size_t length);
+
+    /// Ends the current field, the value of which ends at content_end in
+    /// m_buf.
+    void finish_field(size_t content_end);
+
+    void start_record(size_t pos);
+    void emit_record(std::uint64_t end_offset);
+
+    /// Copies what refers to m_buf into the arena, since m_buf becomes invalid
+    /// after pos.
+    void release_buffer(size_t pos);
+
+    void set_buffer(const char *data, size_t size, std::uint64_t offset);
+
+private:
+    record_callback m_callback;
+    options m_options;
+    csv_separator_set m_separators;
+    csv_block_scanner m_scanner;
+
+    // Buffer being parsed.
+    const char *m_buf {nullptr};
+    size_t m_buf_size {0};
+    std::uint64_t m_buf_offset {0}; // offset of m_buf in input
+
+    std::uint64_t m_input_size {0}; // number of bytes given to parse()
+
+    // Bytes at the end of the previous chunk which might start a separator,
+    // and the buffer in which they are parsed with the next chunk.
+    std::string m_held;
+    std::string m_stitch;
+
+    state m_state {state::q0};
+    bool m_record_started {false};
+    size_t m_run_start {0};              // start of the field value not copied yet in m_buf
+    size_t m_quote_pos {0};              // position of the double quote read in q3
+    bool m_quote_in_prev_buffer {false}; // whether that double quote is in a previous buffer
+    bool m_field_in_copy {false};        // whether the field value started in m_field_copy
+    std::string m_field_copy;
+
+    std::vector<field_ref> m_fields;
+    std::string m_arena;
+    csv_record m_record;
+};
+
+#endif // CSV_PARSER_H
@@ -0,0 +1,343 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_record_index.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const char index_magic[8] = {'C', 'S', 'V', 'R', 'I', 'D', 'X', '\x01'};
+
+void put_u64(std::string &out, std::uint64_t value)
+{
+    for(int i = 0; i < 8; i++) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+bool get_u64(const std::string &in, size_t &pos, std::uint64_t &value)
+{
+    if(in.size() - pos < 8) {
+        return false;
+    }
+    value = 0;
+    for(int i = 0; i < 8; i++) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[pos++])) << (8 * i);
+    }
+    return true;
+}
+
+/// Appends value using 7 bits per byte, the high bit of each byte but the
+/// last being set.
+void put_varint(std::string &out, std::uint64_t value)
+{
+    while(value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+bool get_varint(const std::string &in, size_t &pos, std::uint64_t &value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        const unsigned char byte = static_cast<unsigned char>(in[pos++]);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if(!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Returns the size of a file, or -1 if it cannot be opened.
+std::int64_t file_size(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return file.is_open() ? static_cast<std::int64_t>(file.tellg()) : -1;
+}
+
+} // namespace
+
+csv_record_index::csv_record_index(const options &opts)
+    : m_options(opts)
+    , m_interval(std::max<std::uint64_t>(opts.interval, 1))
+{
+    clear();
+}
+
+void csv_record_index::add_record(const csv_record &record)
+{
+    if(record.index == m_offsets.size() * m_interval) {
+        m_offsets.push_back(record.begin_offset);
+    }
+}
+
+csv_parser::record_callback csv_record_index::indexing_callback(
+    const csv_parser::record_callback &callback
+)
+{
+    return [this, callback](const csv_record &record) {
+        add_record(record);
+        if(callback) {
+            callback(record);
+        }
+    };
+}
+
+void csv_record_index::finish(std::uint64_t input_size, std::uint64_t record_count)
+{
+    m_complete = true;
+    m_input_size = input_size;
+    m_record_count = record_count;
+}
+
+bool csv_record_index::resume(
+    const std::string &filename,
+    const csv_parser::record_callback &callback,
+    const std::string &index_filename
+)
+{
+    const checkpoint &start = last_checkpoint();
+    return parse_from(filename, start.record_index, static_cast<std::uint64_t>(-1),
+                      callback, index_filename);
+}
+
+bool csv_record_index::parse_records(
+    const std::string &filename,
+    std::uint64_t first,
+    std::uint64_t count,
+    const csv_parser::record_callback &callback
+)
+{
+    if(count == 0) {
+        return true;
+    }
+    const std::uint64_t last = first + count - 1;
+    return parse_from(filename, first, last < first ? static_cast<std::uint64_t>(-1) : last,
+                      callback, "");
+}
+
+csv_record_index::checkpoint csv_record_index::seek(std::uint64_t record_index) const
+{
+    const std::uint64_t i = std::min<std::uint64_t>(record_index / m_interval,
+                                                    m_offsets.size() - 1);
+    checkpoint result;
+    result.record_index = i * m_interval;
+    result.offset = m_offsets[static_cast<size_t>(i)];
+    return result;
+}
+
+bool csv_record_index::save(const std::string &index_filename) const
+{
+    std::string data(index_magic, sizeof(index_magic));
+    put_u64(data, fingerprint());
+    put_u64(data, m_input_size);
+    put_u64(data, m_interval);
+    put_u64(data, m_complete ? 1 : 0);
+    put_u64(data, m_record_count);
+    put_u64(data, m_offsets.size());
+    for(size_t i = 1; i < m_offsets.size(); i++) {
+        put_varint(data, m_offsets[i] - m_offsets[i-1]);
+    }
+
+    // write a temporary file first so that an interrupted save leaves the
+    // previous index intact
+    const std::string &temp_filename = index_filename + ".tmp";
+    {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        if(!file.write(data.data(), data.size())) {
+            return false;
+        }
+    }
+    if(std::rename(temp_filename.c_str(), index_filename.c_str()) == 0) {
+        return true;
+    }
+    // rename() does not replace existing files on some systems
+    std::remove(index_filename.c_str());
+    return std::rename(temp_filename.c_str(), index_filename.c_str()) == 0;
+}
+
+bool csv_record_index::load(const std::string &index_filename, const std::string &filename)
+{
+    m_error.clear();
+    std::ifstream file(index_filename, std::ios::binary);
+    if(!file.is_open()) {
+        m_error = "cannot open " + index_filename;
+        return false;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    const std::string &data = content.str();
+
+    std::uint64_t hash = 0;
+    std::uint64_t input_size = 0;
+    std::uint64_t interval = 0;
+    std::uint64_t complete = 0;
+    std::uint64_t record_count = 0;
+    std::uint64_t checkpoint_count = 0;
+    size_t pos = sizeof(index_magic);
+    if(data.compare(0, sizeof(index_magic), index_magic, sizeof(index_magic)) != 0
+        || !get_u64(data, pos, hash) || !get_u64(data, pos, input_size)
+        || !get_u64(data, pos, interval) || !get_u64(data, pos, complete)
+        || !get_u64(data, pos, record_count) || !get_u64(data, pos, checkpoint_count)
+        || interval == 0 || checkpoint_count == 0 || checkpoint_count > data.size()) {
+        m_error = index_filename + " is not a record index";
+        return false;
+    }
+    if(hash != fingerprint()) {
+        m_error = index_filename + " was built using other parser options";
+        return false;
+    }
+    const std::int64_t size = file_size(filename);
+    if(size < 0 || (input_size != 0 && static_cast<std::uint64_t>(size) != input_size)) {
+        m_error = index_filename + " does not match " + filename;
+        return false;
+    }
+
+    std::vector<std::uint64_t> offsets(1, 0);
+    offsets.reserve(static_cast<size_t>(checkpoint_count));
+    while(offsets.size() < checkpoint_count) {
+        std::uint64_t delta = 0;
+        if(!get_varint(data, pos, delta) || delta == 0) {
+            m_error = index_filename + " is not a record index";
+            return false;
+        }
+        offsets.push_back(offsets.back() + delta);
+    }
+
+    m_interval = interval;
+    m_offsets.swap(offsets);
+    m_complete = complete != 0;
+    m_input_size = input_size;
+    m_record_count = record_count;
+    return true;
+}
+
+void csv_record_index::clear()
+{
+    m_offsets.assign(1, 0);
+    m_complete = false;
+    m_input_size = 0;
+    m_record_count = 0;
+}
+
+bool csv_record_index::parse_from(
+    const std::string &filename,
+    std::uint64_t first,
+    std::uint64_t last,
+    const csv_parser::record_callback &callback,
+    const std::string &index_filename
+)
+{
+    m_error.clear();
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if(!file.is_open()) {
+        m_error = "cannot open " + filename;
+        return false;
+    }
+    const std::uint64_t size = static_cast<std::uint64_t>(file.tellg());
+    if(m_input_size == 0 && !m_complete) {
+        m_input_size = size;
+    }
+    else if(m_input_size != size) {
+        m_error = "the index does not match " + filename + " (file size changed)";
+        return false;
+    }
+
+    const checkpoint &start = seek(first);
+    file.seekg(static_cast<std::streamoff>(start.offset));
+
+    bool done = false;
+    bool saved = true;
+    csv_parser parser([&](const csv_record &record) {
+        if(done) {
+            return;
+        }
+        const size_t count = m_offsets.size();
+        add_record(record);
+        if(m_offsets.size() != count && !index_filename.empty()
+            && (m_offsets.size() - 1) % std::max<std::uint64_t>(m_options.save_interval, 1) == 0) {
+            saved = save(index_filename) && saved;
+        }
+        if(record.index >= first && callback) {
+            callback(record);
+        }
+        done = record.index >= last;
+    }, m_options.parser);
+    parser.reset(start.offset, start.record_index);
+
+    std::vector<char> chunk(std::max<size_t>(m_options.read_size, 1));
+    std::uint64_t offset = start.offset;
+    while(!done && file) {
+        file.read(chunk.data(), chunk.size());
+        const size_t read = static_cast<size_t>(file.gcount());
+        offset += read;
+        parser.parse(chunk.data(), read);
+    }
+    if(file.bad()) {
+        m_error = "cannot read " + filename;
+        return false;
+    }
+    if(!done) {
+        parser.end();
+        finish(offset, parser.record_count());
+        if(!index_filename.empty()) {
+            saved = save(index_filename) && saved;
+        }
+    }
+    if(!saved) {
+        m_error = "cannot write " + index_filename;
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t csv_record_index::fingerprint() const
+{
+    // FNV-1a over the separators, each followed by a null byte, field and
+    // line separators being delimited by another byte
+    std::uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const std::string &s) {
+        for(const char c : s) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        hash = hash * 1099511628211ull;
+    };
+    for(const std::string &separator : m_options.parser.field_separators) {
+        add(separator);
+    }
+    add("\x01");
+    for(const std::string &separator : m_options.parser.line_separators) {
+        add(separator);
+    }
+    return hash;
+}
@@ -0,0 +1,164 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_RECORD_INDEX_H
+#define CSV_RECORD_INDEX_H
+
+#include "csv_parser.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Sparse index of the records of a CSV file, giving the offset at which every
+/// interval-th record begins so that any record can be reached without parsing
+/// the file from its beginning: offsets cannot be guessed from line separators
+/// since these may be enclosed in double quotes (R6).
+///
+/// Checkpoints are record boundaries, where the state machine is always in q0
+/// with no field pending, so the offset and index of a record are the whole
+/// state needed for a csv_parser to resume there (see csv_parser::reset()).
+/// Checkpoint i is the beginning of record i * interval, the first one being
+/// the beginning of input.
+///
+/// The index is built while parsing, either by the index itself or through
+/// the callback of another parse, and can be saved to a sidecar file. It may
+/// be saved before the file has been fully parsed, in which case parsing
+/// resumes from the last checkpoint.
+class csv_record_index
+{
+public:
+    struct options {
+        csv_parser::options parser;        // options of the parser, part of the index
+        std::uint64_t interval {4096};     // number of records between checkpoints
+        std::uint64_t save_interval {256}; // number of checkpoints between saves while parsing
+        size_t read_size {1 << 20};        // number of bytes read from the file at once
+    };
+
+    struct checkpoint {
+        std::uint64_t record_index {0};
+        std::uint64_t offset {0};
+    };
+
+public:
+    explicit csv_record_index(const options &opts);
+
+    /// Adds a checkpoint if record is the next one to be indexed. Records must
+    /// be given in input order, those already indexed being ignored.
+    void add_record(const csv_record &record);
+
+    /// Returns a callback adding checkpoints for the records it receives
+    /// before passing them to callback (if any), so as to build the index
+    /// while parsing for another purpose. The index must outlive the callback.
+    csv_parser::record_callback indexing_callback(const csv_parser::record_callback &callback);
+
+    /// Marks the index as complete for an input of the given size, which holds
+    /// the given number of records.
+    void finish(std::uint64_t input_size, std::uint64_t record_count);
+
+    /// Parses a file from the last checkpoint, passing the following records
+    /// to callback (if any) and adding checkpoints until the end of the file.
+    /// Resumes an interrupted parse when the index has been loaded from an
+    /// incomplete sidecar file; the records from the last checkpoint on are
+    /// passed again in that case. The index is saved to index_filename (if
+    /// not empty) every save_interval checkpoints and once complete. Returns
+    /// false if a file cannot be read or written, in which case error()
+    /// describes the reason.
+    bool resume(const std::string &filename,
+                const csv_parser::record_callback &callback,
+                const std::string &index_filename = "");
+
+    /// Same as above without callback: builds or completes the index.
+    bool build(const std::string &filename,
+               const std::string &index_filename = "")
+    { return resume(filename, csv_parser::record_callback(), index_filename); }
+
+    /// Passes count records of a file to callback starting with the record at
+    /// index first, parsing from the last checkpoint before it. Checkpoints
+    /// are added along the way if the index is incomplete. Returns false if
+    /// the file cannot be read.
+    bool parse_records(const std::string &filename,
+                       std::uint64_t first,
+                       std::uint64_t count,
+                       const csv_parser::record_callback &callback);
+
+    /// Returns the last checkpoint at or before the record at index
+    /// record_index.
+    checkpoint seek(std::uint64_t record_index) const;
+
+    /// Returns the last checkpoint of the index.
+    checkpoint last_checkpoint() const { return seek(static_cast<std::uint64_t>(-1)); }
+
+    /// Writes the index to a sidecar file. Checkpoint offsets are stored as
+    /// variable-length deltas after a header holding a fingerprint of the
+    /// parser options and the size of the CSV file.
+    bool save(const std::string &index_filename) const;
+
+    /// Reads an index written by save() for the given CSV file. Fails if the
+    /// sidecar file is invalid, was written using other parser options or for
+    /// a file of another size, in which case the index is left unchanged.
+    bool load(const std::string &index_filename, const std::string &filename);
+
+    /// Discards all checkpoints but the first one.
+    void clear();
+
+    bool complete() const { return m_complete; }
+
+    /// Number of records of input, if the index is complete.
+    std::uint64_t record_count() const { return m_record_count; }
+
+    size_t checkpoint_count() const { return m_offsets.size(); }
+
+    std::uint64_t interval() const { return m_interval; }
+
+    const options& get_options() const { return m_options; }
+
+    const std::string& error() const { return m_error; }
+
+private:
+    /// Parses a file from the last checkpoint before the record at index
+    /// first until the record at index last is complete, or the end of the
+    /// file is reached.
+    bool parse_from(const std::string &filename,
+                    std::uint64_t first,
+                    std::uint64_t last,
+                    const csv_parser::record_callback &callback,
+                    const std::string &index_filename);
+
+    /// Returns a hash of the options affecting record boundaries.
+    std::uint64_t fingerprint() const;
+
+private:
+    options m_options;
+    std::uint64_t m_interval;
+    std::vector<std::uint64_t> m_offsets; // offset of checkpoint i
+    bool m_complete {false};
+    std::uint64_t m_input_size {0};   // size of input, or of the file being indexed
+    std::uint64_t m_record_count {0};
+    std::string m_error;
+};
+
+#endif // CSV_RECORD_INDEX_H
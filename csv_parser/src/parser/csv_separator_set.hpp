@@ -0,0 +1,175 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_SEPARATOR_SET_H
+#define CSV_SEPARATOR_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Field and line separators compiled for matching, so that the cost of
+/// recognizing a separator does not depend on how many are configured:
+///     - a byte-class lookup table gives whether a byte starts a separator,
+///       and the kind of single-byte separators that do not start a longer
+///       separator, which are recognized without comparing strings.
+///     - for each byte, a verification list holds the separators starting
+///       with it by decreasing length, to recognize multi-byte separators.
+/// The first bytes of separators are meant to be found in input by
+/// csv_block_scanner, whose classifier handles any number of bytes.
+class csv_separator_set
+{
+public:
+    enum class kind : std::uint8_t { none, field, line, undecided };
+
+    /// Throws std::invalid_argument if a separator is empty, contains a double
+    /// quote, or is both a field and a line separator.
+    explicit csv_separator_set(const std::vector<std::string> &field_separators,
+                               const std::vector<std::string> &line_separators)
+    {
+        std::vector<separator> separators;
+        auto add_separators = [&](const std::vector<std::string> &strs, kind k) {
+            for(const std::string &str : strs) {
+                if(str.empty() || str.find('"') != std::string::npos) {
+                    throw std::invalid_argument("invalid CSV separator: \"" + str + "\"");
+                }
+                for(const separator &sep : separators) {
+                    if(sep.str == str && sep.k != k) {
+                        throw std::invalid_argument("CSV separator used for both fields and lines: \"" + str + "\"");
+                    }
+                }
+                separators.push_back({str, k});
+                m_length_max = std::max(m_length_max, str.size());
+            }
+        };
+        add_separators(field_separators, kind::field);
+        add_separators(line_separators, kind::line);
+        std::stable_sort(separators.begin(), separators.end(),
+                         [](const separator &a, const separator &b) {
+                             return a.str.size() > b.str.size();
+                         });
+
+        // Group separators by first byte, keeping the order by decreasing
+        // length in each group.
+        std::fill(m_classes, m_classes + 256, 0);
+        std::fill(m_first, m_first + 257, 0);
+        for(const separator &sep : separators) {
+            m_first[static_cast<unsigned char>(sep.str[0]) + 1]++;
+        }
+        for(size_t c = 0; c < 256; c++) {
+            m_first[c + 1] += m_first[c];
+        }
+        m_separators.resize(separators.size());
+        std::vector<std::uint32_t> next(m_first, m_first + 256);
+        for(const separator &sep : separators) {
+            m_separators[next[static_cast<unsigned char>(sep.str[0])]++] = sep;
+        }
+
+        for(size_t c = 0; c < 256; c++) {
+            const std::uint32_t count = m_first[c + 1] - m_first[c];
+            if(count == 0) {
+                continue;
+            }
+            m_first_chars.push_back(static_cast<char>(c));
+            m_classes[c] = first_char_class;
+            // The longest separator of the group is first.
+            const separator &longest = m_separators[m_first[c]];
+            if(longest.str.size() == 1) {
+                m_classes[c] |= longest.k == kind::field ? single_field_class : single_line_class;
+            }
+        }
+    }
+
+    /// Returns whether c is the first byte of a separator.
+    bool is_first_char(char c) const
+    { return m_classes[static_cast<unsigned char>(c)] & first_char_class; }
+
+    /// Returns the kind of the separator made of c alone, if it does not start
+    /// a longer separator, and kind::none otherwise.
+    kind single_char_kind(char c) const
+    {
+        const std::uint8_t byte_class = m_classes[static_cast<unsigned char>(c)];
+        return (byte_class & single_field_class) ? kind::field
+             : (byte_class & single_line_class) ? kind::line
+             : kind::none;
+    }
+
+    /// Returns the kind of the longest separator at the beginning of the size
+    /// bytes of s and sets length to its length. kind::undecided is returned
+    /// if a longer separator might match given more bytes, unless final is
+    /// true.
+    kind match(const char *s, size_t size, bool final, size_t &length) const
+    {
+        const kind single = single_char_kind(s[0]);
+        if(single != kind::none) {
+            length = 1;
+            return single;
+        }
+
+        const unsigned char c = static_cast<unsigned char>(s[0]);
+        for(std::uint32_t i = m_first[c]; i < m_first[c + 1]; i++) {
+            const separator &sep = m_separators[i];
+            if(sep.str.size() <= size) {
+                if(std::memcmp(s, sep.str.data(), sep.str.size()) == 0) {
+                    length = sep.str.size();
+                    return sep.k;
+                }
+            }
+            else if(!final && std::memcmp(s, sep.str.data(), size) == 0) {
+                return kind::undecided; // a longer separator might match
+            }
+        }
+        return kind::none;
+    }
+
+    /// Length of the longest separator.
+    size_t length_max() const { return m_length_max; }
+
+    /// Distinct first bytes of the separators.
+    const std::vector<char>& first_chars() const { return m_first_chars; }
+
+private:
+    struct separator {
+        std::string str;
+        kind k;
+    };
+
+    static const std::uint8_t first_char_class = 1;
+    static const std::uint8_t single_field_class = 2;
+    static const std::uint8_t single_line_class = 4;
+
+    std::uint8_t m_classes[256];
+    std::uint32_t m_first[257];           // separators starting with byte c are [m_first[c], m_first[c+1])
+    std::vector<separator> m_separators;  // grouped by first byte
+    std::vector<char> m_first_chars;
+    size_t m_length_max {0};
+};
+
+#endif // CSV_SEPARATOR_SET_H
@@ -0,0 +1,281 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "csv_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+const char* field_data(const std::string &field) { return field.data(); }
+const char* field_data(const csv_field_view &field) { return field.data; }
+
+size_t field_size(const std::string &field) { return field.size(); }
+size_t field_size(const csv_field_view &field) { return field.size; }
+
+} // namespace
+
+std::string csv_writer::stats::descr() const
+{
+    std::ostringstream stream;
+    stream << records << " records, "
+           << fields << " fields ("
+           << quoted_fields << " quoted, "
+           << zero_copy_fields << " zero-copy), "
+           << bytes << " bytes";
+    return stream.str();
+}
+
+csv_writer::csv_writer(const output_callback &output, const options &opts)
+    : m_output(output)
+    , m_options(opts)
+    , m_separators(parser_options().field_separators, parser_options().line_separators)
+    , m_scanner(m_separators.first_chars())
+{
+    reserve(m_options.buffer_size);
+}
+
+csv_writer::csv_writer(const output_callback &output)
+    : csv_writer(output, options())
+{}
+
+csv_writer::~csv_writer()
+{
+    flush();
+}
+
+void csv_writer::write_field(const char *data, size_t size)
+{
+    if(m_record_fields++ > 0) {
+        append(m_options.field_separator.data(), m_options.field_separator.size());
+    }
+    m_stats.fields++;
+
+    if(m_options.quote_all) {
+        m_stats.quoted_fields++;
+        write_quoted(data, size);
+    }
+    else if(size >= m_options.zero_copy_size) {
+        if(needs_quotes(data, size)) {
+            m_stats.quoted_fields++;
+            write_quoted(data, size);
+        }
+        else {
+            m_stats.zero_copy_fields++;
+            flush();
+            m_output(data, size);
+            m_stats.bytes += size;
+        }
+    }
+    else {
+        const size_t pos = m_size;
+        append(data, size);
+        if(buffer_needs_quotes(pos, size)) {
+            m_size = pos;
+            m_stats.quoted_fields++;
+            write_quoted(data, size);
+        }
+    }
+
+    if(m_size >= m_options.buffer_size) {
+        flush();
+    }
+}
+
+void csv_writer::end_record()
+{
+    append(m_options.line_separator.data(), m_options.line_separator.size());
+    m_record_fields = 0;
+    m_stats.records++;
+    if(m_size >= m_options.buffer_size) {
+        flush();
+    }
+}
+
+void csv_writer::write_record(const std::vector<std::string> &fields)
+{
+    write_fields(fields);
+    end_record();
+}
+
+void csv_writer::write_record(const csv_record &record)
+{
+    write_fields(record.fields);
+    end_record();
+}
+
+void csv_writer::flush()
+{
+    if(m_size > 0) {
+        m_output(m_buffer.data(), m_size);
+        m_stats.bytes += m_size;
+        m_size = 0;
+    }
+}
+
+bool csv_writer::needs_quotes(const char *data, size_t size) const
+{
+    size_t i = 0;
+    for(; i + csv_block_scanner::block_size <= size; i += csv_block_scanner::block_size) {
+        std::uint64_t quotes;
+        std::uint64_t chars;
+        m_scanner.classify(data + i, quotes, chars);
+        if(quotes | chars) {
+            return true;
+        }
+    }
+    for(; i < size; i++) {
+        if(data[i] == '"' || m_separators.is_first_char(data[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+csv_parser::options csv_writer::parser_options() const
+{
+    csv_parser::options opts;
+    opts.field_separators = {m_options.field_separator};
+    std::vector<std::string> &line_separators = opts.line_separators;
+    if(std::find(line_separators.begin(), line_separators.end(), m_options.line_separator)
+        == line_separators.end()) {
+        line_separators.push_back(m_options.line_separator);
+    }
+    return opts;
+}
+
+void csv_writer::reserve(size_t size)
+{
+    const size_t needed = m_size + size + csv_block_scanner::block_size;
+    if(needed > m_buffer.size()) {
+        m_buffer.resize(std::max(needed, 2 * m_buffer.size()));
+    }
+}
+
+bool csv_writer::buffer_needs_quotes(size_t pos, size_t size) const
+{
+    for(size_t i = 0; i < size; i += csv_block_scanner::block_size) {
+        std::uint64_t quotes;
+        std::uint64_t chars;
+        m_scanner.classify(m_buffer.data() + pos + i, quotes, chars);
+        const size_t left = size - i;
+        const std::uint64_t mask = left >= csv_block_scanner::block_size
+                                 ? ~0ULL : ~csv_block_scanner::mask_from(left);
+        if((quotes | chars) & mask) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void csv_writer::write_quoted(const char *data, size_t size)
+{
+    append('"');
+    const char *end = data + size;
+    while(data != end) {
+        const char *quote = static_cast<const char *>(std::memchr(data, '"', end - data));
+        if(!quote) {
+            append(data, end - data);
+            break;
+        }
+        append(data, quote + 1 - data);
+        append('"'); // escaped double quote (R7)
+        data = quote + 1;
+    }
+    append('"');
+}
+
+template<typename Field>
+void csv_writer::write_fields(const std::vector<Field> &fields)
+{
+    bool batch = !m_options.quote_all && m_record_fields == 0;
+    for(size_t i = 0; batch && i < fields.size(); i++) {
+        batch = field_size(fields[i]) < m_options.zero_copy_size;
+    }
+    if(!batch) {
+        for(const Field &field : fields) {
+            write_field(field_data(field), field_size(field));
+        }
+        return;
+    }
+
+    const std::string &separator = m_options.field_separator;
+    const size_t begin = m_size;
+    m_field_ends.clear();
+    for(size_t i = 0; i < fields.size(); i++) {
+        if(i > 0) {
+            append(separator.data(), separator.size());
+        }
+        append(field_data(fields[i]), field_size(fields[i]));
+        m_field_ends.push_back(m_size);
+    }
+    m_record_fields = fields.size();
+    m_stats.fields += fields.size();
+
+    // Mark the fields holding a byte detected outside separators.
+    m_field_quoted.assign(fields.size(), 0);
+    size_t first_quoted = fields.size();
+    size_t field = 0;
+    for(size_t pos = begin; pos < m_size; pos += csv_block_scanner::block_size) {
+        std::uint64_t quotes;
+        std::uint64_t chars;
+        m_scanner.classify(m_buffer.data() + pos, quotes, chars);
+        const size_t left = m_size - pos;
+        std::uint64_t bits = (quotes | chars) & (left >= csv_block_scanner::block_size
+                                                 ? ~0ULL : ~csv_block_scanner::mask_from(left));
+        for(; bits; bits &= bits - 1) {
+            const size_t byte_pos = pos + csv_block_scanner::lowest_bit(bits);
+            while(m_field_ends[field] <= byte_pos) {
+                field++;
+            }
+            if(byte_pos >= (field > 0 ? m_field_ends[field-1] + separator.size() : begin)) {
+                m_field_quoted[field] = 1;
+                first_quoted = std::min(first_quoted, field);
+            }
+        }
+    }
+    if(first_quoted == fields.size()) {
+        return;
+    }
+
+    // Rewrite the fields from the first marked one on, the fields before it
+    // being written as they should.
+    m_size = first_quoted > 0 ? m_field_ends[first_quoted-1] : begin;
+    for(field = first_quoted; field < fields.size(); field++) {
+        if(field > 0) {
+            append(separator.data(), separator.size());
+        }
+        if(m_field_quoted[field]) {
+            m_stats.quoted_fields++;
+            write_quoted(field_data(fields[field]), field_size(fields[field]));
+        }
+        else {
+            append(field_data(fields[field]), field_size(fields[field]));
+        }
+    }
+}
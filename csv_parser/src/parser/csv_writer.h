@@ -0,0 +1,166 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include "csv_block_scanner.hpp"
+#include "csv_parser.h"
+#include "csv_separator_set.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Writes records compliant with RFC 4180 that csv_parser reads back exactly
+/// using parser_options(). Fields are enclosed in double quotes only when they
+/// contain a double quote or the first byte of a separator (R5 - R7), which
+/// is detected in blocks of 64 bytes by csv_block_scanner, and double quotes
+/// inside them are doubled.
+///
+/// Output is accumulated in a buffer reused across records and passed to a
+/// callback once buffer_size bytes have been written, on flush() and on
+/// destruction. Fields are copied to the buffer before being classified
+/// there, so that short fields are classified in whole blocks too, and are
+/// rewritten enclosed in double quotes if needed; whole records are
+/// classified at once. Fields which need no double quotes and are at least
+/// zero_copy_size bytes long are passed to the callback directly instead of
+/// being copied to the buffer. Records without fields are written as empty
+/// lines, which are read back as records with one empty field.
+class csv_writer
+{
+public:
+    struct options {
+        std::string field_separator {","};
+        std::string line_separator {"\r\n"};
+        bool quote_all {false};            // whether all fields are enclosed in double quotes
+        size_t buffer_size {1 << 20};      // number of bytes buffered before output
+        size_t zero_copy_size {16 * 1024}; // minimum size of the fields output without copy
+    };
+
+    /// Statistics about the records written so far.
+    struct stats {
+        std::uint64_t records {0};
+        std::uint64_t fields {0};
+        std::uint64_t quoted_fields {0};    // fields enclosed in double quotes
+        std::uint64_t zero_copy_fields {0}; // fields passed to the output callback directly
+        std::uint64_t bytes {0};            // bytes passed to the output callback
+
+        /// Convenient informative function.
+        std::string descr() const;
+    };
+
+    /// Receives output, the data being only valid during the call.
+    typedef std::function<void (const char *data, size_t size)> output_callback;
+
+public:
+    /// Throws std::invalid_argument if a separator is empty, contains a double
+    /// quote, or if the field separator is one of the line separators of
+    /// parser_options().
+    explicit csv_writer(const output_callback &output,
+                        const options &opts);
+
+    /// Same as above using default options.
+    explicit csv_writer(const output_callback &output);
+
+    ~csv_writer();
+
+    /// Appends a field to the current record.
+    void write_field(const char *data, size_t size);
+
+    void write_field(const std::string &s) { write_field(s.data(), s.size()); }
+
+    void write_field(const csv_field_view &field) { write_field(field.data, field.size); }
+
+    /// Ends the current record.
+    void end_record();
+
+    /// Writes a whole record.
+    void write_record(const std::vector<std::string> &fields);
+
+    void write_record(const csv_record &record);
+
+    /// Passes buffered output to the callback.
+    void flush();
+
+    /// Returns whether a field value must be enclosed in double quotes.
+    bool needs_quotes(const char *data, size_t size) const;
+
+    /// Returns the parser options reading written records back: the field
+    /// separator, and the line separator along with the default ones.
+    csv_parser::options parser_options() const;
+
+    const options& get_options() const { return m_options; }
+
+    const stats& run_stats() const { return m_stats; }
+
+private:
+    /// Makes room for size more bytes in the buffer, followed by at least one
+    /// block of bytes which may be read but hold no output.
+    void reserve(size_t size);
+
+    void append(const char *data, size_t size)
+    {
+        reserve(size);
+        std::memcpy(m_buffer.data() + m_size, data, size);
+        m_size += size;
+    }
+
+    void append(char c)
+    {
+        reserve(1);
+        m_buffer[m_size++] = c;
+    }
+
+    /// Returns whether the size bytes at pos in the buffer need double quotes,
+    /// classifying whole blocks thanks to the bytes reserved after them.
+    bool buffer_needs_quotes(size_t pos, size_t size) const;
+
+    /// Appends a field value enclosed in double quotes to the buffer.
+    void write_quoted(const char *data, size_t size);
+
+    /// Writes the fields of a record, copying them all to the buffer before
+    /// classifying them at once: most blocks then hold several fields, only
+    /// separators being detected in them.
+    template<typename Field>
+    void write_fields(const std::vector<Field> &fields);
+
+private:
+    output_callback m_output;
+    options m_options;
+    csv_separator_set m_separators;
+    csv_block_scanner m_scanner;
+    std::vector<char> m_buffer;
+    size_t m_size {0}; // number of bytes of output in m_buffer
+    size_t m_record_fields {0};         // number of fields written in the current record
+    std::vector<size_t> m_field_ends;   // end of each field of the record written by write_fields()
+    std::vector<char> m_field_quoted;   // whether each of these fields needs double quotes
+    stats m_stats;
+};
+
+#endif // CSV_WRITER_H
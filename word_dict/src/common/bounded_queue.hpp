@@ -0,0 +1,102 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/// A thread-safe FIFO queue holding a limited number of elements. Producers
+/// block while the queue is full, which slows them down to the pace of the
+/// consumers (backpressure), and consumers block while the queue is empty.
+template<typename T>
+class bounded_queue
+{
+public:
+    explicit bounded_queue(size_t capacity)
+        : m_capacity(capacity > 0 ? capacity : 1)
+    {
+    }
+
+    bounded_queue(const bounded_queue &) = delete;
+    bounded_queue& operator=(const bounded_queue &) = delete;
+
+    /// Appends an element to the queue, waiting for room if necessary. Returns
+    /// false if the queue has been closed, in which case the element is
+    /// dropped.
+    bool push(T value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [this]() {
+            return m_closed || m_elements.size() < m_capacity;
+        });
+        if(m_closed) {
+            return false;
+        }
+        m_elements.push_back(std::move(value));
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /// Removes the first element of the queue, waiting for one if necessary.
+    /// Returns false once the queue is closed and no element is left.
+    bool pop(T &value)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this]() {
+            return m_closed || !m_elements.empty();
+        });
+        if(m_elements.empty()) {
+            return false;
+        }
+        value = std::move(m_elements.front());
+        m_elements.pop_front();
+        m_not_full.notify_one();
+        return true;
+    }
+
+    /// Closes the queue: further calls to push() fail, and calls to pop() fail
+    /// as soon as the remaining elements have been removed.
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+private:
+    const size_t m_capacity;
+    std::deque<T> m_elements;
+    bool m_closed {false};
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+};
+
+#endif // BOUNDED_QUEUE_H
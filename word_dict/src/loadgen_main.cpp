@@ -0,0 +1,254 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "query_client.h"
+#include "timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock steady_clock_t;
+
+struct loadgen_options {
+    std::string socket_path;
+    unsigned int connections {4};       // number of concurrent connections
+    std::uint64_t requests {200000};    // total number of requests
+    unsigned int pipeline_depth {16};   // requests in flight per connection
+    query_protocol::operation op {query_protocol::operation::levenshtein};
+    unsigned int cost {1};
+    bool typos {false};                 // whether one character of each word is replaced
+};
+
+/// Deterministic pseudo-random number generator (xorshift64).
+class xorshift64
+{
+public:
+    explicit xorshift64(std::uint64_t seed) : m_state(seed ? seed : 1) {}
+
+    std::uint64_t next()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return m_state;
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+void print_usage(const std::string &program)
+{
+    std::cerr << "usage: " << program << " <socket path> <words file>"
+                 " [--connections <count>] [--requests <count>]"
+                 " [--pipeline <depth>] [--op exact|subst|leven]"
+                 " [--cost <cost>] [--typos]" << std::endl
+              << std::endl
+              << "Sends queries for words picked from the given file to"
+                 " word_dict_server and reports throughput and latency"
+                 " percentiles." << std::endl;
+}
+
+/// Returns the latency at the given percentile in sorted latencies.
+double percentile(const std::vector<double> &sorted_latencies, double p)
+{
+    if(sorted_latencies.empty()) {
+        return 0;
+    }
+    const size_t index = static_cast<size_t>(p / 100 * (sorted_latencies.size() - 1) + 0.5);
+    return sorted_latencies[index];
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    if(args.size() < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    loadgen_options opts;
+    opts.socket_path = args[0];
+    try {
+        for(size_t i = 2; i < args.size(); i++) {
+            if(args[i] == "--connections" && i + 1 < args.size()) {
+                opts.connections = std::max(1ul, std::stoul(args[++i]));
+            }
+            else if(args[i] == "--requests" && i + 1 < args.size()) {
+                opts.requests = std::stoull(args[++i]);
+            }
+            else if(args[i] == "--pipeline" && i + 1 < args.size()) {
+                opts.pipeline_depth = std::max(1ul, std::stoul(args[++i]));
+            }
+            else if(args[i] == "--op" && i + 1 < args.size()) {
+                const std::string &op = args[++i];
+                if(op == "exact") {
+                    opts.op = query_protocol::operation::exact;
+                }
+                else if(op == "subst") {
+                    opts.op = query_protocol::operation::substitution;
+                }
+                else if(op == "leven") {
+                    opts.op = query_protocol::operation::levenshtein;
+                }
+                else {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+            }
+            else if(args[i] == "--cost" && i + 1 < args.size()) {
+                opts.cost = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--typos") {
+                opts.typos = true;
+            }
+            else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch(const std::logic_error &) { // std::invalid_argument or std::out_of_range
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> words;
+    {
+        std::ifstream file(args[1]);
+        std::string line;
+        while(std::getline(file, line)) {
+            if(!line.empty()) {
+                words.push_back(line);
+            }
+        }
+    }
+    if(words.empty()) {
+        std::cerr << "[-] unable to read words from file " << args[1] << std::endl;
+        return 1;
+    }
+
+    // Each connection runs in its own thread and keeps pipeline_depth requests
+    // in flight, the latency of a request being the time between its sending
+    // and the reception of its response.
+    std::mutex results_mutex;
+    std::vector<double> latencies; // in microseconds
+    latencies.reserve(opts.requests);
+    std::uint64_t found = 0;
+    std::uint64_t bad_requests = 0;
+    std::uint64_t incomplete = 0;
+    bool failed = false;
+
+    timer tm;
+    std::vector<std::thread> threads;
+    for(unsigned int c = 0; c < opts.connections; c++) {
+        threads.emplace_back([&, c]() {
+            const std::uint64_t quota = opts.requests / opts.connections
+                                      + (c < opts.requests % opts.connections ? 1 : 0);
+            std::vector<double> local_latencies;
+            local_latencies.reserve(quota);
+            std::vector<steady_clock_t::time_point> send_times(quota); // indexed by request id
+            std::uint64_t local_found = 0;
+            std::uint64_t local_bad_requests = 0;
+            std::uint64_t local_incomplete = 0;
+            xorshift64 rng(0x9E3779B97F4A7C15ull * (c + 1));
+
+            query_client client;
+            bool ok = client.connect(opts.socket_path);
+            std::uint64_t sent = 0;
+            std::uint64_t received = 0;
+            while(ok && received < quota) {
+                while(sent < quota && sent - received < opts.pipeline_depth) {
+                    query_protocol::request req;
+                    req.id = static_cast<std::uint32_t>(sent);
+                    req.op = opts.op;
+                    req.cost = static_cast<std::uint8_t>(opts.cost);
+                    req.str = words[rng.next() % words.size()];
+                    if(opts.typos) {
+                        req.str[rng.next() % req.str.size()] = static_cast<char>('a' + rng.next() % 26);
+                    }
+                    send_times[sent] = steady_clock_t::now();
+                    client.send(req);
+                    sent++;
+                }
+                ok = client.flush();
+
+                query_protocol::response res;
+                ok = ok && client.receive(res);
+                if(ok) {
+                    const auto latency = steady_clock_t::now() - send_times[res.id];
+                    local_latencies.push_back(std::chrono::duration<double, std::micro>(latency).count());
+                    local_found += res.st == query_protocol::status::found ? 1 : 0;
+                    local_bad_requests += res.st == query_protocol::status::bad_request ? 1 : 0;
+                    local_incomplete += res.st == query_protocol::status::incomplete ? 1 : 0;
+                    received++;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(results_mutex);
+            if(!ok) {
+                std::cerr << "[-] connection " << c << ": " << client.error() << std::endl;
+                failed = true;
+            }
+            latencies.insert(latencies.end(), local_latencies.begin(), local_latencies.end());
+            found += local_found;
+            bad_requests += local_bad_requests;
+            incomplete += local_incomplete;
+        });
+    }
+    for(std::thread &thread : threads) {
+        thread.join();
+    }
+    const double elapsed_time = tm.elapsed_time();
+
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "[-] " << latencies.size() << " requests over "
+              << opts.connections << " connections (pipeline depth "
+              << opts.pipeline_depth << ") in "
+              << static_cast<long long>(elapsed_time) << " ms" << std::endl
+              << "    " << found << " found, " << incomplete << " incomplete, "
+              << bad_requests << " bad requests" << std::endl
+              << "    QPS: " << static_cast<long long>(elapsed_time > 0 ? latencies.size() / (elapsed_time / 1000) : 0) << std::endl
+              << "    latency (us): p50 " << percentile(latencies, 50)
+              << ", p90 " << percentile(latencies, 90)
+              << ", p99 " << percentile(latencies, 99)
+              << ", p99.9 " << percentile(latencies, 99.9)
+              << ", max " << (latencies.empty() ? 0 : latencies.back())
+              << std::endl;
+    return failed ? 1 : 0;
+}
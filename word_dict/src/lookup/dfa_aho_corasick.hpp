@@ -0,0 +1,174 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef DFA_AHO_CORASICK_H
+#define DFA_AHO_CORASICK_H
+
+#include "dfa_tree.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Aho-Corasick automaton finding all occurrences of the strings of a dfa_tree
+/// inside a text in a single pass, instead of matching every substring of the
+/// text against the tree. Strings are sequences of T read from the root node
+/// up to a node having a child for end_marker, as in dfa_string_dict; with
+/// T = uint32_t, strings may be sequences of token ids such as phrases.
+///
+/// The nodes of the tree (end_marker children excluded) are numbered in
+/// breadth-first order, so that the children of a node have consecutive
+/// numbers and are stored as a sorted range of a single label array. Each
+/// node is given:
+///     - a failure link to the node reading the longest proper suffix of its
+///       string that is also a prefix of a tree string, followed when a text
+///       character cannot be read.
+///     - an output link to the nearest node along failure links ending a tree
+///       string, so that all strings ending at a text position are reported
+///       without following failure links one at a time.
+/// The automaton is a snapshot: strings added to the tree afterwards are not
+/// found until it is built again.
+template<typename T>
+class dfa_aho_corasick
+{
+public:
+    typedef std::uint32_t node_id;
+
+    static const node_id root_id = 0;
+    static const node_id no_node = static_cast<node_id>(-1);
+
+public:
+    /// Builds the automaton of the strings of tree.
+    explicit dfa_aho_corasick(const dfa_tree<T> &tree, const T &end_marker)
+    {
+        typedef typename dfa_tree<T>::node_t node_t;
+
+        // Number nodes in breadth-first order.
+        std::vector<const node_t*> nodes(1, &tree.root());
+        m_labels.push_back(T());
+        m_depths.push_back(0);
+        for(size_t i = 0; i < nodes.size(); i++) {
+            m_first_child.push_back(static_cast<node_id>(nodes.size()));
+            bool word = false;
+            for(auto it = nodes[i]->begin(); it != nodes[i]->end(); it++) {
+                if(it->first == end_marker) {
+                    word = true;
+                    continue;
+                }
+                nodes.push_back(&it->second);
+                m_labels.push_back(it->first);
+                m_depths.push_back(m_depths[i] + 1);
+            }
+            m_words.push_back(word);
+        }
+        m_first_child.push_back(static_cast<node_id>(nodes.size()));
+
+        // Compute links in breadth-first order, the links of a node depending
+        // on nodes of lower depth only.
+        m_failures.assign(nodes.size(), root_id);
+        m_outputs.assign(nodes.size(), no_node);
+        for(node_id parent = 0; parent < nodes.size(); parent++) {
+            for(node_id child = m_first_child[parent]; child < m_first_child[parent+1]; child++) {
+                if(parent != root_id) {
+                    m_failures[child] = next(m_failures[parent], m_labels[child]);
+                }
+                const node_id failure = m_failures[child];
+                m_outputs[child] = m_words[failure] ? failure : m_outputs[failure];
+            }
+        }
+    }
+
+    /// Passes every occurrence of a tree string in the length characters of
+    /// text to callback(offset, length), in order of end position then of
+    /// decreasing length. Empty strings are not reported.
+    template<typename Callback>
+    void scan(const T *text, size_t length, Callback callback) const
+    {
+        node_id node = root_id;
+        for(size_t i = 0; i < length; i++) {
+            node = next(node, text[i]);
+            for(node_id match = m_words[node] ? node : m_outputs[node];
+                match != no_node && match != root_id;
+                match = m_outputs[match]) {
+                callback(i + 1 - m_depths[match], static_cast<size_t>(m_depths[match]));
+            }
+        }
+    }
+
+    /// Returns the node reached from node by reading input, following failure
+    /// links when node has no child for input.
+    node_id next(node_id node, const T &input) const
+    {
+        while(true) {
+            const node_id child = child_id(node, input);
+            if(child != no_node) {
+                return child;
+            }
+            if(node == root_id) {
+                return root_id;
+            }
+            node = m_failures[node];
+        }
+    }
+
+    /// Returns the child of node for input, or no_node.
+    node_id child_id(node_id node, const T &input) const
+    {
+        const auto begin = m_labels.begin() + m_first_child[node];
+        const auto end = m_labels.begin() + m_first_child[node+1];
+        const auto it = std::lower_bound(begin, end, input);
+        return it != end && *it == input ? static_cast<node_id>(it - m_labels.begin()) : no_node;
+    }
+
+    /// Returns the number of nodes, root node excluded.
+    size_t number_of_nodes() const { return m_labels.size() - 1; }
+
+    /// Returns an estimate of the memory used by the automaton in bytes.
+    size_t approximate_memory_usage() const
+    {
+        return m_labels.size() * sizeof(T)
+             + (m_first_child.size() + m_failures.size() + m_outputs.size() + m_depths.size())
+               * sizeof(node_id)
+             + m_words.size() / 8;
+    }
+
+private:
+    std::vector<T> m_labels;             // input read to reach each node
+    std::vector<node_id> m_first_child;  // first child of each node, followed by the number of nodes
+    std::vector<node_id> m_failures;     // failure link of each node
+    std::vector<node_id> m_outputs;      // output link of each node, or no_node
+    std::vector<node_id> m_depths;       // length of the string read to reach each node
+    std::vector<bool> m_words;           // whether each node ends a tree string
+};
+
+template<typename T>
+const typename dfa_aho_corasick<T>::node_id dfa_aho_corasick<T>::root_id;
+
+template<typename T>
+const typename dfa_aho_corasick<T>::node_id dfa_aho_corasick<T>::no_node;
+
+#endif // DFA_AHO_CORASICK_H
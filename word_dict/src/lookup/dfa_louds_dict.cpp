@@ -0,0 +1,514 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "dfa_louds_dict.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <queue>
+
+namespace {
+
+const char louds_magic[8] = {'W', 'D', 'L', 'O', 'U', 'D', 'S', '\x01'};
+const size_t block_bits = 512;
+
+size_t popcount(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    size_t count = 0;
+    for(; word; word &= word - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Returns 64 if word is 0.
+size_t lowest_bit(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return word ? static_cast<size_t>(__builtin_ctzll(word)) : 64;
+#else
+    size_t i = 0;
+    while(i < 64 && !(word & 1)) {
+        word >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+void write_u64(std::ostream &stream, std::uint64_t value)
+{
+    char bytes[8];
+    for(int i = 0; i < 8; i++) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    stream.write(bytes, sizeof(bytes));
+}
+
+bool read_u64(std::istream &stream, std::uint64_t &value)
+{
+    char bytes[8];
+    if(!stream.read(bytes, sizeof(bytes))) {
+        return false;
+    }
+    value = 0;
+    for(int i = 0; i < 8; i++) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    }
+    return true;
+}
+
+void write_words(std::ostream &stream, const std::vector<std::uint64_t> &words)
+{
+    for(const std::uint64_t word : words) {
+        write_u64(stream, word);
+    }
+}
+
+bool read_words(std::istream &stream, std::vector<std::uint64_t> &words)
+{
+    for(std::uint64_t &word : words) {
+        if(!read_u64(stream, word)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the number of bytes left to read from stream, or the largest value
+// if it cannot be known.
+std::uint64_t bytes_left(std::istream &stream)
+{
+    const std::istream::pos_type pos = stream.tellg();
+    if(pos == std::istream::pos_type(-1)) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    stream.seekg(0, std::ios::end);
+    const std::istream::pos_type end = stream.tellg();
+    stream.seekg(pos);
+    if(!stream || end == std::istream::pos_type(-1) || end < pos) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(end - pos);
+}
+
+// Returns whether the bits of words after the first size bits are all 0.
+bool has_zero_padding(const std::vector<std::uint64_t> &words, size_t size)
+{
+    return size % 64 == 0 || !(words.back() >> (size % 64));
+}
+
+} // namespace
+
+void dfa_louds_dict::bit_vector::push_back(bool bit)
+{
+    if(m_size % 64 == 0) {
+        m_words.push_back(0);
+    }
+    m_words.back() |= static_cast<std::uint64_t>(bit) << (m_size % 64);
+    m_size++;
+}
+
+void dfa_louds_dict::bit_vector::build_directories()
+{
+    const size_t block_count = (m_size + block_bits - 1) / block_bits;
+    m_ranks.assign(block_count + 1, 0);
+    m_selects.clear();
+    size_t ones = 0;
+    size_t zeros = 0;
+    for(size_t block = 0; block < block_count; block++) {
+        m_ranks[block] = static_cast<std::uint32_t>(ones);
+        const size_t block_end = std::min(m_size, (block + 1) * block_bits);
+        for(size_t w = block * block_bits / 64; w * 64 < block_end; w++) {
+            ones += popcount(m_words[w]);
+        }
+        const size_t block_zeros = block_end - ones - zeros;
+        while(m_selects.size() * block_bits + 1 <= zeros + block_zeros) {
+            m_selects.push_back(static_cast<std::uint32_t>(block));
+        }
+        zeros += block_zeros;
+    }
+    m_ranks[block_count] = static_cast<std::uint32_t>(ones);
+    m_words.shrink_to_fit();
+}
+
+size_t dfa_louds_dict::bit_vector::rank1(size_t pos) const
+{
+    size_t rank = m_ranks[pos / block_bits];
+    for(size_t w = pos / block_bits * block_bits / 64; w < pos / 64; w++) {
+        rank += popcount(m_words[w]);
+    }
+    if(pos % 64) {
+        rank += popcount(m_words[pos / 64] & ((1ULL << (pos % 64)) - 1));
+    }
+    return rank;
+}
+
+size_t dfa_louds_dict::bit_vector::select0(size_t k) const
+{
+    // Find the block holding the k-th 0 bit from the nearest sample.
+    auto zeros_before = [this](size_t block) { return block * block_bits - m_ranks[block]; };
+    size_t block = m_selects[(k - 1) / block_bits];
+    while(block + 1 < m_ranks.size() - 1 && zeros_before(block + 1) < k) {
+        block++;
+    }
+
+    // Then the word holding it, and its position in the word.
+    size_t rank = k - zeros_before(block);
+    size_t w = block * block_bits / 64;
+    while(true) {
+        const size_t word_zeros = 64 - popcount(m_words[w]);
+        if(rank <= word_zeros) {
+            break;
+        }
+        rank -= word_zeros;
+        w++;
+    }
+    std::uint64_t zero_bits = ~m_words[w];
+    for(; rank > 1; rank--) {
+        zero_bits &= zero_bits - 1;
+    }
+    return w * 64 + lowest_bit(zero_bits);
+}
+
+size_t dfa_louds_dict::bit_vector::memory_usage() const
+{
+    return m_words.capacity() * sizeof(std::uint64_t)
+         + (m_ranks.capacity() + m_selects.capacity()) * sizeof(std::uint32_t);
+}
+
+dfa_louds_dict::dfa_louds_dict()
+{
+    // Single root node without children.
+    m_louds.push_back(true);
+    m_louds.push_back(false);
+    m_louds.push_back(false);
+    m_louds.build_directories();
+    m_terminals.push_back(false);
+}
+
+dfa_louds_dict::dfa_louds_dict(const dfa_string_dict &dict)
+{
+    const char end_marker = dfa_string_dict::tree_end_of_string_marker;
+    m_louds.push_back(true);
+    m_louds.push_back(false);
+
+    std::queue<const dfa_tree<char>::node_t*> unvisited_nodes;
+    unvisited_nodes.push(&dict.tree().root());
+    while(!unvisited_nodes.empty()) {
+        const dfa_tree<char>::node_t *node = unvisited_nodes.front();
+        unvisited_nodes.pop();
+        bool terminal = false;
+        for(auto it = node->begin(); it != node->end(); it++) {
+            if(it->first == end_marker) {
+                terminal = true;
+                continue;
+            }
+            m_louds.push_back(true);
+            m_labels += it->first;
+            unvisited_nodes.push(&it->second);
+        }
+        m_louds.push_back(false);
+        m_terminals.push_back(terminal);
+    }
+    m_louds.build_directories();
+    m_labels.shrink_to_fit();
+}
+
+bool dfa_louds_dict::contains_string(const std::string &str) const
+{
+    size_t node = 0;
+    for(const char c : str) {
+        node = child(node, c);
+        if(!node) {
+            return false;
+        }
+    }
+    return is_terminal(node);
+}
+
+bool dfa_louds_dict::match_allow_substitution(
+    const std::string &str,
+    unsigned int subst_max,
+    std::string &matched,
+    unsigned int &cost
+) const
+{
+    // Same logic as dfa_string_dict::search_allow_substitution(). Nodes are
+    // visited depth first, each unvisited node being stored with the length
+    // of the string read before it and the substitutions used to read it.
+    // That string is held by the first characters of path, which are not
+    // overwritten until all the nodes below it have been visited.
+
+    typedef unsigned int uint;
+
+    const uint s_len = str.length();
+    if(s_len == 0) {
+        matched.clear();
+        cost = 0;
+        return is_terminal(0);
+    }
+
+    struct entry { size_t node; uint depth; uint cost; };
+    std::vector<entry> unvisited_nodes;
+    size_t first;
+    size_t count;
+    children(0, first, count);
+    for(size_t i = 0; i < count; i++) {
+        unvisited_nodes.push_back({first + i, 0, 0});
+    }
+    std::string path;
+
+    while(!unvisited_nodes.empty()) {
+        const entry curr = unvisited_nodes.back();
+        unvisited_nodes.pop_back();
+        const char c = m_labels[curr.node - 1];
+        const uint curr_cost = curr.cost + (c == str[curr.depth] ? 0 : 1);
+        if(curr_cost > subst_max) {
+            continue;
+        }
+
+        path.resize(curr.depth);
+        path += c;
+        if(curr.depth + 1 == s_len) {
+            if(is_terminal(curr.node)) {
+                matched = path;
+                cost = curr_cost;
+                return true;
+            }
+            continue;
+        }
+        children(curr.node, first, count);
+        for(size_t i = 0; i < count; i++) {
+            unvisited_nodes.push_back({first + i, curr.depth + 1, curr_cost});
+        }
+    }
+    return false;
+}
+
+bool dfa_louds_dict::match_levenshtein_distance(
+    const std::string &str,
+    unsigned int edit_max,
+    std::string &matched,
+    unsigned int &cost
+) const
+{
+    // Same logic as dfa_string_dict::search_levenshtein_distance(), nodes
+    // being visited as in match_allow_substitution(). The rows of the
+    // Levenshtein distance matrix are stored one after the other in rows, row
+    // d being the row after reading d characters, so the row of a node is
+    // computed from the row of its parent, which is still there.
+
+    typedef unsigned int uint;
+
+    const uint row_size = str.length() + 1;
+    std::vector<uint> rows(row_size);
+    for(uint i = 0; i < row_size; i++) {
+        rows[i] = i;
+    }
+    if(is_terminal(0) && rows[row_size-1] <= edit_max) {
+        matched.clear();
+        cost = rows[row_size-1];
+        return true;
+    }
+
+    struct entry { size_t node; uint depth; };
+    std::vector<entry> unvisited_nodes;
+    size_t first;
+    size_t count;
+    children(0, first, count);
+    for(size_t i = 0; i < count; i++) {
+        unvisited_nodes.push_back({first + i, 0});
+    }
+    std::string path;
+
+    while(!unvisited_nodes.empty()) {
+        const entry curr = unvisited_nodes.back();
+        unvisited_nodes.pop_back();
+        const char c = m_labels[curr.node - 1];
+        if(rows.size() < (curr.depth + 2) * row_size) {
+            rows.resize((curr.depth + 2) * row_size);
+        }
+
+        const uint *prev_row = rows.data() + curr.depth * row_size;
+        uint *curr_row = rows.data() + (curr.depth + 1) * row_size;
+        curr_row[0] = prev_row[0] + 1;
+        uint row_min = curr_row[0];
+        for(uint j = 1; j < row_size; j++) {
+            curr_row[j] = std::min({
+                curr_row[j-1] + 1, // insertion cost
+                prev_row[j] + 1, // deletion cost
+                prev_row[j-1] + (c == str[j-1] ? 0 : 1), // substitution cost
+            });
+            row_min = std::min(row_min, curr_row[j]);
+        }
+
+        path.resize(curr.depth);
+        path += c;
+        if(is_terminal(curr.node) && curr_row[row_size-1] <= edit_max) {
+            matched = path;
+            cost = curr_row[row_size-1];
+            return true;
+        }
+        if(row_min > edit_max) {
+            continue;
+        }
+        children(curr.node, first, count);
+        for(size_t i = 0; i < count; i++) {
+            unvisited_nodes.push_back({first + i, curr.depth + 1});
+        }
+    }
+    return false;
+}
+
+bool dfa_louds_dict::save(std::ostream &stream) const
+{
+    stream.write(louds_magic, sizeof(louds_magic));
+    write_u64(stream, m_labels.size());
+    write_words(stream, m_louds.words());
+    write_words(stream, m_terminals.words());
+    stream.write(m_labels.data(), m_labels.size());
+    return static_cast<bool>(stream);
+}
+
+bool dfa_louds_dict::save(const std::string &filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    return file.is_open() && save(file);
+}
+
+bool dfa_louds_dict::load(std::istream &stream)
+{
+    char magic[sizeof(louds_magic)];
+    std::uint64_t node_count = 0;
+    if(!stream.read(magic, sizeof(magic))
+        || !std::equal(magic, magic + sizeof(magic), louds_magic)
+        || !read_u64(stream, node_count)) {
+        return false;
+    }
+
+    // node_count + 1 nodes (root node included) give as many 1 bits and one
+    // more 0 bit, after the leading "10". The directories count bits on 32
+    // bits, and the encoding must fit in what is left of the stream.
+    if(node_count > (std::numeric_limits<std::uint32_t>::max() - 3) / 2) {
+        return false;
+    }
+    const std::uint64_t louds_size = 2 * node_count + 3;
+    if(8 * ((louds_size + 63) / 64 + (node_count + 64) / 64) + node_count > bytes_left(stream)) {
+        return false;
+    }
+    bit_vector louds;
+    bit_vector terminals;
+    std::string labels;
+    louds.resize(louds_size);
+    terminals.resize(node_count + 1);
+    if(!read_words(stream, louds.words()) || !read_words(stream, terminals.words())) {
+        return false;
+    }
+    labels.resize(node_count);
+    if(!stream.read(&labels[0], labels.size())) {
+        return false;
+    }
+    if(!louds.at(0) || louds.at(1) || louds.at(louds.size() - 1)
+        || !has_zero_padding(louds.words(), louds.size())
+        || !has_zero_padding(terminals.words(), terminals.size())) {
+        return false;
+    }
+
+    // The children of node k follow the (k+1)-th 0 bit, so node k must have
+    // been declared by then, i.e. at least k + 1 1 bits must come first. This
+    // gives every child a larger number than its parent.
+    size_t ones = 0;
+    size_t zeros = 0;
+    for(size_t pos = 0; pos < louds.size(); pos++) {
+        if(louds.at(pos)) {
+            ones++;
+        }
+        else if(++zeros <= node_count + 1 && ones < zeros) {
+            return false;
+        }
+    }
+    if(ones != node_count + 1) {
+        return false;
+    }
+    louds.build_directories();
+
+    m_louds = louds;
+    m_terminals = terminals;
+    m_labels.swap(labels);
+    return true;
+}
+
+bool dfa_louds_dict::load(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return file.is_open() && load(file);
+}
+
+size_t dfa_louds_dict::memory_usage() const
+{
+    return sizeof(*this) + m_louds.memory_usage() + m_terminals.memory_usage()
+         + m_labels.capacity();
+}
+
+void dfa_louds_dict::children(size_t node, size_t &first, size_t &count) const
+{
+    // The 1 bits of the children of node follow the (node+1)-th 0 bit, the
+    // i-th 1 bit being node i.
+    const size_t begin = m_louds.select0(node + 1) + 1;
+    first = m_louds.rank1(begin);
+
+    // Count the consecutive 1 bits from begin.
+    const std::vector<std::uint64_t> &words = m_louds.words();
+    count = 0;
+    for(size_t pos = begin;;) {
+        const size_t shift = pos % 64;
+        const std::uint64_t zero_bits = ~(words[pos / 64] >> shift);
+        const size_t ones = lowest_bit(zero_bits);
+        if(ones < 64 - shift) {
+            count += ones;
+            break;
+        }
+        count += 64 - shift;
+        pos += 64 - shift;
+    }
+}
+
+size_t dfa_louds_dict::child(size_t node, char c) const
+{
+    size_t first;
+    size_t count;
+    children(node, first, count);
+    const auto begin = m_labels.begin() + (first - 1);
+    const auto end = begin + count;
+    const auto it = std::lower_bound(begin, end, c);
+    return it != end && *it == c ? static_cast<size_t>(it - m_labels.begin()) + 1 : 0;
+}
@@ -0,0 +1,146 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef DFA_LOUDS_DICT_H
+#define DFA_LOUDS_DICT_H
+
+#include "dfa_string_dict.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// A static dictionary of strings encoding the character tree of a
+/// dfa_string_dict in about 11 bits per node, for hosts where several
+/// dictionaries must be held in memory at once. Queries run directly on the
+/// encoding, more slowly than on the character tree since locating the
+/// children of a node takes a few bit operations instead of a pointer.
+///
+/// The tree is encoded using LOUDS (Level-Order Unary Degree Sequence): nodes
+/// are numbered in breadth-first order, root node first, and each node is
+/// written as one 1 bit per child followed by a 0 bit, after a leading "10"
+/// standing for the root node. Node i is the i-th 1 bit, and its children are
+/// the consecutive nodes whose 1 bits follow the (i+1)-th 0 bit, found using
+/// rank and select operations. Besides:
+///     - labels holds the character read to reach each node (8 bits per node).
+///     - a bit per node tells whether a string ends there, end of string
+///       markers not being stored as nodes.
+class dfa_louds_dict
+{
+public:
+    /// Builds an empty dictionary, meant to be loaded.
+    explicit dfa_louds_dict();
+
+    /// Encodes the strings of dict.
+    explicit dfa_louds_dict(const dfa_string_dict &dict);
+
+    /// Returns whether str has been added to the encoded dictionary.
+    bool contains_string(const std::string &str) const;
+
+    /// Searches for a string requiring at most subst_max substitutions of
+    /// str. On success, matched is set to the string found and cost to the
+    /// number of substitutions.
+    bool match_allow_substitution(const std::string &str,
+                                  unsigned int subst_max,
+                                  std::string &matched,
+                                  unsigned int &cost) const;
+
+    /// Same as above allowing edit_max edits (Levenshtein distance).
+    bool match_levenshtein_distance(const std::string &str,
+                                    unsigned int edit_max,
+                                    std::string &matched,
+                                    unsigned int &cost) const;
+
+    /// Writes the encoding to stream. Returns false on failure.
+    bool save(std::ostream &stream) const;
+
+    /// Same as above to a file.
+    bool save(const std::string &filename) const;
+
+    /// Reads an encoding written by save(). Returns false if it is invalid,
+    /// in which case the dictionary is left unchanged.
+    bool load(std::istream &stream);
+
+    /// Same as above from a file.
+    bool load(const std::string &filename);
+
+    /// Returns the number of nodes, root node excluded.
+    size_t number_of_nodes() const { return m_labels.size(); }
+
+    /// Returns the memory used by the encoding and its rank/select
+    /// directories in bytes.
+    size_t memory_usage() const;
+
+private:
+    /// Bit vector supporting rank of 1 bits and select of 0 bits in constant
+    /// time, using a directory holding the number of 1 bits before each block
+    /// of 512 bits and the block of every 512th 0 bit.
+    class bit_vector
+    {
+    public:
+        void push_back(bool bit);
+        bool at(size_t pos) const { return (m_words[pos / 64] >> (pos % 64)) & 1; }
+        size_t size() const { return m_size; }
+
+        /// Builds the directories, once all bits have been pushed.
+        void build_directories();
+
+        /// Returns the number of 1 bits before pos.
+        size_t rank1(size_t pos) const;
+
+        /// Returns the position of the k-th 0 bit (k >= 1).
+        size_t select0(size_t k) const;
+
+        size_t memory_usage() const;
+
+        std::vector<std::uint64_t>& words() { return m_words; }
+        const std::vector<std::uint64_t>& words() const { return m_words; }
+        void resize(size_t size) { m_size = size; m_words.assign((size + 63) / 64, 0); }
+
+    private:
+        std::vector<std::uint64_t> m_words;
+        size_t m_size {0};
+        std::vector<std::uint32_t> m_ranks;   // 1 bits before each block
+        std::vector<std::uint32_t> m_selects; // block of the (512 j + 1)-th 0 bit
+    };
+
+    /// Sets first and count to the first child of node and its number of
+    /// children.
+    void children(size_t node, size_t &first, size_t &count) const;
+
+    /// Returns the child of node labeled c, or 0.
+    size_t child(size_t node, char c) const;
+
+    bool is_terminal(size_t node) const { return m_terminals.at(node); }
+
+private:
+    bit_vector m_louds;
+    bit_vector m_terminals; // whether a string ends at each node
+    std::string m_labels;   // label of node i + 1 at index i
+};
+
+#endif // DFA_LOUDS_DICT_H
@@ -0,0 +1,308 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef DFA_MATCHER_H
+#define DFA_MATCHER_H
+
+#include "dfa_tree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+/// Matching algorithms usable as the Policy parameter of dfa_matcher.
+struct exact_match_policy {};
+struct substitution_match_policy {};
+struct levenshtein_match_policy {};
+
+/// String matching algorithms for a character tree where the maximum cost K is
+/// known at compile time. Cost checks and loop bounds are therefore constants
+/// the compiler can fold and unroll, and no memory is allocated during tree
+/// traversal, unlike in the dfa_string_dict algorithms which must handle any
+/// cost at runtime.
+///
+/// Each specialization provides the following function, where s is the string
+/// to match followed by end_marker (i.e. the end of string marker of the
+/// tree), and on success matched is set to the tree string found (including
+/// end_marker) and cost to the cost of the match:
+///     static bool match(const dfa_tree<char>::node_t &root,
+///                       const std::string &s,
+///                       char end_marker,
+///                       std::string &matched,
+///                       unsigned int &cost);
+template<typename Policy, unsigned int K>
+class dfa_matcher;
+
+/// Exact matching: K must be 0.
+template<unsigned int K>
+class dfa_matcher<exact_match_policy, K>
+{
+    static_assert(K == 0, "exact matching does not allow any cost");
+
+public:
+    static bool match(const dfa_tree<char>::node_t &root,
+                      const std::string &s,
+                      char end_marker,
+                      std::string &matched,
+                      unsigned int &cost)
+    {
+        (void)end_marker; // s already ends with the end of string marker
+
+        const dfa_tree<char>::node_t *node = &root;
+        for(const char c : s) {
+            node = node->child_ptr(c);
+            if(!node) {
+                return false;
+            }
+        }
+        matched = s;
+        cost = 0;
+        return true;
+    }
+};
+
+/// Substitution matching: at most K substitutions.
+template<unsigned int K>
+class dfa_matcher<substitution_match_policy, K>
+{
+public:
+    static bool match(const dfa_tree<char>::node_t &root,
+                      const std::string &s,
+                      char end_marker,
+                      std::string &matched,
+                      unsigned int &cost)
+    {
+        (void)end_marker; // the end of string marker is never substituted
+
+        matched.clear();
+        return step<0>::visit(root, s.data(), s.data() + s.length(),
+                              matched, cost);
+    }
+
+private:
+    /// Visits the children of node knowing that Cost substitutions have been
+    /// used to read the current tree string, which is stored in path.
+    template<unsigned int Cost, bool Exhausted = (Cost >= K)>
+    struct step
+    {
+        static bool visit(const dfa_tree<char>::node_t &node,
+                          const char *s_it,
+                          const char *s_end,
+                          std::string &path,
+                          unsigned int &cost)
+        {
+            const char expected_char = *s_it;
+            if(s_it + 1 == s_end) {
+                // Only the end of string marker is left to read, which cannot
+                // be substituted.
+                if(!node.child_ptr(expected_char)) {
+                    return false;
+                }
+                path.push_back(expected_char);
+                cost = Cost;
+                return true;
+            }
+
+            for(auto it = node.begin(); it != node.end(); it++) {
+                path.push_back(it->first);
+                const bool found = it->first == expected_char
+                    ? step<Cost>::visit(it->second, s_it + 1, s_end, path, cost)
+                    : step<Cost + 1>::visit(it->second, s_it + 1, s_end, path, cost);
+                if(found) {
+                    return true;
+                }
+                path.pop_back();
+            }
+            return false;
+        }
+    };
+
+    /// Same as above once no substitution is allowed anymore: the rest of the
+    /// string must be read exactly.
+    template<unsigned int Cost>
+    struct step<Cost, true>
+    {
+        static bool visit(const dfa_tree<char>::node_t &node,
+                          const char *s_it,
+                          const char *s_end,
+                          std::string &path,
+                          unsigned int &cost)
+        {
+            const size_t path_length = path.length();
+            const dfa_tree<char>::node_t *curr_node = &node;
+            for(; s_it != s_end; s_it++) {
+                curr_node = curr_node->child_ptr(*s_it);
+                if(!curr_node) {
+                    path.resize(path_length);
+                    return false;
+                }
+                path.push_back(*s_it);
+            }
+            cost = Cost;
+            return true;
+        }
+    };
+};
+
+/// Levenshtein matching: at most K substitutions, insertions and deletions.
+template<unsigned int K>
+class dfa_matcher<levenshtein_match_policy, K>
+{
+public:
+    static bool match(const dfa_tree<char>::node_t &root,
+                      const std::string &s,
+                      char end_marker,
+                      std::string &matched,
+                      unsigned int &cost)
+    {
+        // Same algorithm as dfa_string_dict::match_string_levenshtein_distance()
+        // except that only a band of 2K+1 cells is computed in each row of the
+        // Levenshtein distance matrix, since a cell at row i and column j
+        // cannot hold a value lower than |i - j|. Cell b in the band of row i
+        // corresponds to column j = i - K + b.
+
+        const unsigned int out_of_bound = K + 1;
+        band_t row;
+        for(unsigned int b = 0; b < band_size; b++) {
+            const long long j = static_cast<long long>(b) - K;
+            row[b] = (j >= 0 && j <= static_cast<long long>(s.length()))
+                   ? static_cast<unsigned int>(j)
+                   : out_of_bound;
+        }
+
+        matched.clear();
+        return visit(root, 0, row, s, end_marker, matched, cost);
+    }
+
+private:
+    static const unsigned int band_size = 2 * K + 1;
+    typedef std::array<unsigned int, band_size> band_t;
+
+    static bool visit(const dfa_tree<char>::node_t &node,
+                      unsigned int depth,
+                      const band_t &prev_row,
+                      const std::string &s,
+                      char end_marker,
+                      std::string &path,
+                      unsigned int &cost)
+    {
+        const unsigned int out_of_bound = K + 1; // value of cells outside the band
+        const long long s_len = s.length();
+        const long long curr_depth = depth + 1;
+
+        for(auto it = node.begin(); it != node.end(); it++) {
+            // Compute current row in Levenshtein distance matrix.
+            band_t curr_row;
+            unsigned int curr_row_min_cost = out_of_bound;
+            for(unsigned int b = 0; b < band_size; b++) {
+                const long long j = curr_depth - K + b;
+                if(j < 0 || j > s_len) {
+                    curr_row[b] = out_of_bound;
+                    continue;
+                }
+                unsigned int cell = b + 1 < band_size
+                                  ? prev_row[b+1] + 1 // deletion cost
+                                  : out_of_bound;
+                if(b > 0) {
+                    cell = std::min(cell, curr_row[b-1] + 1); // insertion cost
+                }
+                if(j > 0) {
+                    cell = std::min(cell, prev_row[b] + (it->first == s[j-1] ? 0 : 1)); // substitution cost
+                }
+                curr_row[b] = std::min(cell, out_of_bound);
+                curr_row_min_cost = std::min(curr_row_min_cost, curr_row[b]);
+            }
+
+            // Check if we have reached a string matching the given edit
+            // distance criteria.
+            if(it->first == end_marker) {
+                const long long goal_b = s_len - curr_depth + K;
+                if(goal_b >= 0 && goal_b < band_size && curr_row[goal_b] <= K) {
+                    path.push_back(it->first);
+                    cost = curr_row[goal_b];
+                    return true;
+                }
+                continue;
+            }
+
+            // Visit the tree node if the maximum edit cost has not been
+            // exceeded.
+            if(curr_row_min_cost <= K) {
+                path.push_back(it->first);
+                if(visit(it->second, depth + 1, curr_row, s, end_marker, path, cost)) {
+                    return true;
+                }
+                path.pop_back();
+            }
+        }
+        return false;
+    }
+};
+
+/// Largest cost for which dfa_matcher is instantiated by dfa_matcher_dispatch.
+const unsigned int dfa_matcher_max_cost = 2;
+
+/// Runtime dispatcher selecting the dfa_matcher specialization for a given
+/// cost.
+class dfa_matcher_dispatch
+{
+public:
+    dfa_matcher_dispatch() = delete;
+
+    /// Runs dfa_matcher<Policy, cost_max>::match() and stores its result in
+    /// s_matched. Returns false without doing anything if cost_max exceeds
+    /// dfa_matcher_max_cost, in which case the caller should fall back to an
+    /// algorithm handling any cost. A cost of 0 always results in exact
+    /// matching.
+    template<typename Policy>
+    static bool match(const dfa_tree<char>::node_t &root,
+                      const std::string &s,
+                      char end_marker,
+                      unsigned int cost_max,
+                      bool &s_matched,
+                      std::string &matched,
+                      unsigned int &cost)
+    {
+        switch(cost_max) {
+        case 0:
+            s_matched = dfa_matcher<exact_match_policy, 0>::match(
+                root, s, end_marker, matched, cost);
+            return true;
+        case 1:
+            s_matched = dfa_matcher<Policy, 1>::match(
+                root, s, end_marker, matched, cost);
+            return true;
+        case 2:
+            s_matched = dfa_matcher<Policy, 2>::match(
+                root, s, end_marker, matched, cost);
+            return true;
+        default:
+            return false;
+        }
+    }
+};
+
+#endif // DFA_MATCHER_H
@@ -0,0 +1,181 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "dfa_query_session.h"
+
+#include <algorithm>
+
+dfa_query_session::dfa_query_session(
+    const dfa_string_dict &dict,
+    unsigned int edit_max
+)
+    : m_dict(dict)
+    , m_edit_max(edit_max)
+{
+    // The frontier of the empty query holds the nodes reached by at most
+    // edit_max insertions.
+    m_paths.push_back({0, '\0'}); // empty string
+    m_path_counts.push_back(m_paths.size());
+    m_frontier_begins.push_back(0);
+    offer(&m_dict.tree().root(), 0, 0);
+    close_frontier();
+}
+
+void dfa_query_session::push_char(char c)
+{
+    const size_t prev_begin = m_frontier_begins.back();
+    const size_t prev_end = m_nodes.size();
+    m_query += c;
+    m_frontier_begins.push_back(prev_end);
+    m_path_counts.push_back(m_paths.size());
+    m_positions.clear();
+
+    for(size_t i = prev_begin; i < prev_end; i++) {
+        const frontier_node prev = m_nodes[i]; // m_nodes grows below
+
+        // c deleted
+        if(prev.distance + 1 <= m_edit_max && improves(prev.node, prev.distance + 1)) {
+            offer(prev.node, prev.path, prev.distance + 1);
+        }
+
+        // c read, or substituted
+        for(auto it = prev.node->begin(); it != prev.node->end(); it++) {
+            if(it->first == dfa_string_dict::tree_end_of_string_marker) {
+                continue;
+            }
+            const std::uint32_t distance = prev.distance + (it->first == c ? 0 : 1);
+            if(distance <= m_edit_max && improves(&it->second, distance)) {
+                offer(&it->second, add_path(prev.path, it->first), distance);
+            }
+        }
+    }
+    close_frontier();
+}
+
+bool dfa_query_session::pop_char()
+{
+    if(m_query.empty()) {
+        return false;
+    }
+    m_query.pop_back();
+    m_nodes.resize(m_frontier_begins.back());
+    m_frontier_begins.pop_back();
+    m_paths.resize(m_path_counts.back());
+    m_path_counts.pop_back();
+    return true;
+}
+
+void dfa_query_session::reset()
+{
+    while(pop_char()) {
+    }
+}
+
+dfa_string_dict::match_result dfa_query_session::match() const
+{
+    const frontier_node *closest = nullptr;
+    for(size_t i = m_frontier_begins.back(); i < m_nodes.size(); i++) {
+        const frontier_node &fn = m_nodes[i];
+        if(is_terminal(fn.node) && (!closest || fn.distance < closest->distance)) {
+            closest = &fn;
+        }
+    }
+
+    const std::string &s = m_query + dfa_string_dict::tree_end_of_string_marker;
+    const std::string &matched = closest ? path_string(closest->path) : std::string();
+    dfa_string_dict::match_result match;
+    match.setData(
+        "leven-session-match(" + std::to_string(m_edit_max) + ")",
+        m_query,
+        closest != nullptr,
+        [&]() { return "\"" + s + "\" matched successfully with \""
+                     + matched + dfa_string_dict::tree_end_of_string_marker
+                     + "\" using " + std::to_string(closest->distance) + " edits"; },
+        [&]() { return "\"" + s + "\" failed to match"; }
+    );
+    if(closest) {
+        match.setMatched(matched, closest->distance);
+    }
+    return match;
+}
+
+bool dfa_query_session::improves(const node_t *node, std::uint32_t distance) const
+{
+    const auto it = m_positions.find(node);
+    return it == m_positions.end() || distance < m_nodes[it->second].distance;
+}
+
+void dfa_query_session::offer(const node_t *node,
+                              std::uint32_t path,
+                              std::uint32_t distance)
+{
+    const auto it = m_positions.find(node);
+    if(it != m_positions.end()) {
+        m_nodes[it->second].path = path;
+        m_nodes[it->second].distance = distance;
+    }
+    else {
+        m_positions[node] = m_nodes.size();
+        m_nodes.push_back({node, path, distance});
+    }
+}
+
+std::uint32_t dfa_query_session::add_path(std::uint32_t parent, char c)
+{
+    m_paths.push_back({parent, c});
+    return static_cast<std::uint32_t>(m_paths.size() - 1);
+}
+
+void dfa_query_session::close_frontier()
+{
+    // A node is expanded once its distance is final, i.e. when nodes at
+    // that distance are, since insertions only offer larger distances.
+    const size_t begin = m_frontier_begins.back();
+    for(std::uint32_t distance = 0; distance < m_edit_max; distance++) {
+        for(size_t i = begin; i < m_nodes.size(); i++) {
+            if(m_nodes[i].distance != distance) {
+                continue;
+            }
+            const frontier_node fn = m_nodes[i]; // m_nodes grows below
+            for(auto it = fn.node->begin(); it != fn.node->end(); it++) {
+                if(it->first != dfa_string_dict::tree_end_of_string_marker
+                && improves(&it->second, distance + 1)) {
+                    offer(&it->second, add_path(fn.path, it->first), distance + 1);
+                }
+            }
+        }
+    }
+}
+
+std::string dfa_query_session::path_string(std::uint32_t path) const
+{
+    std::string str;
+    for(; path != 0; path = m_paths[path].parent) {
+        str += m_paths[path].c;
+    }
+    std::reverse(str.begin(), str.end());
+    return str;
+}
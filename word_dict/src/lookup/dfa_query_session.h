@@ -0,0 +1,144 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef DFA_QUERY_SESSION_H
+#define DFA_QUERY_SESSION_H
+
+#include "dfa_string_dict.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// A Levenshtein query typed one character at a time (type-ahead), matched
+/// against a dfa_string_dict after each keystroke without starting over from
+/// the root node.
+///
+/// The session keeps the frontier of the query: the nodes of the character
+/// tree whose string is within edit_max edits of the query, each with its
+/// smallest edit distance. A node is in the frontier of query + c if and only
+/// if one of the following holds, within edit_max edits:
+///     - the node is in the frontier of query (c deleted: one more edit);
+///     - its parent is, the character read to reach it being c (no edit) or
+///       another character (substitution: one more edit);
+///     - its parent is in the frontier of query + c (character inserted: one
+///       more edit).
+/// So appending a character costs a number of operations proportional to the
+/// size of the frontiers rather than to the length of the query, and the
+/// query matches a string if and only if a node of its frontier ends one.
+/// The frontiers of all the prefixes of the query are kept, so that removing
+/// the last character only drops the last frontier.
+///
+/// The dictionary must not be modified during the session.
+class dfa_query_session
+{
+public:
+    /// Starts a session with an empty query, allowing edit_max edits.
+    explicit dfa_query_session(const dfa_string_dict &dict,
+                               unsigned int edit_max);
+
+    /// Appends c to the query.
+    void push_char(char c);
+
+    /// Removes the last character of the query. Returns false if the query is
+    /// empty.
+    bool pop_char();
+
+    /// Empties the query.
+    void reset();
+
+    const std::string& query() const { return m_query; }
+
+    unsigned int edit_max() const { return m_edit_max; }
+
+    /// Same as dfa_string_dict::match_string_levenshtein_distance() on the
+    /// query, except that the closest string is returned rather than the
+    /// first one found.
+    dfa_string_dict::match_result match() const;
+
+    /// Returns the number of nodes in the frontier of the query.
+    size_t frontier_size() const { return m_nodes.size() - m_frontier_begins.back(); }
+
+private:
+    typedef dfa_tree<char>::node_t node_t;
+
+    /// Node of a frontier.
+    struct frontier_node {
+        const node_t *node;
+        std::uint32_t path;     // index in m_paths of the string read to reach the node
+        std::uint32_t distance; // edit distance from the query to that string
+    };
+
+    /// Last character of a string read from the root node, m_paths[0] being
+    /// the empty string.
+    struct path_step {
+        std::uint32_t parent; // index in m_paths of the string without its last character
+        char c;
+    };
+
+    /// Returns whether node is not in the frontier being built with a
+    /// distance not exceeding distance.
+    bool improves(const node_t *node, std::uint32_t distance) const;
+
+    /// Adds node to the frontier being built, or lowers its distance.
+    void offer(const node_t *node, std::uint32_t path, std::uint32_t distance);
+
+    /// Appends to m_paths the string at index parent followed by c, and
+    /// returns its index.
+    std::uint32_t add_path(std::uint32_t parent, char c);
+
+    /// Adds to the frontier being built the children of its nodes within the
+    /// allowed edits (insertions), in increasing order of distance.
+    void close_frontier();
+
+    /// Returns the string of m_paths at index path.
+    std::string path_string(std::uint32_t path) const;
+
+    bool is_terminal(const node_t *node) const
+    { return node->child_ptr(dfa_string_dict::tree_end_of_string_marker) != nullptr; }
+
+private:
+    const dfa_string_dict &m_dict;
+    unsigned int m_edit_max;
+    std::string m_query;
+
+    // Frontiers of all the prefixes of the query, one after the other, the
+    // frontier of the prefix of length i starting at m_frontier_begins[i].
+    std::vector<frontier_node> m_nodes;
+    std::vector<size_t> m_frontier_begins;
+
+    // Strings read to reach the nodes of the frontiers, and for each prefix
+    // of the query the number of them before its frontier was built.
+    std::vector<path_step> m_paths;
+    std::vector<size_t> m_path_counts;
+
+    // Index in m_nodes of the nodes of the frontier being built.
+    std::unordered_map<const node_t *, size_t> m_positions;
+};
+
+#endif // DFA_QUERY_SESSION_H
@@ -0,0 +1,247 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "dfa_radix_tree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+dfa_radix_tree::dfa_radix_tree(const dfa_tree<char> &tree, char end_marker)
+    : m_end_marker(end_marker)
+{
+    // Nodes are created when their parent is expanded, in breadth-first order:
+    // each pending entry is a created node and the source node its children
+    // are read from, i.e. the last node of its chain.
+    std::vector<std::pair<std::uint32_t, const dfa_tree<char>::node_t*>> pending;
+    m_nodes.push_back(node());
+    m_first_chars.push_back('\0');
+    pending.push_back(std::make_pair(0u, &tree.root()));
+    for(size_t i = 0; i < pending.size(); i++) {
+        const dfa_tree<char>::node_t &source = *pending[i].second;
+        m_nodes[pending[i].first].first_child = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes[pending[i].first].child_count = static_cast<std::uint32_t>(source.number_of_children());
+        for(auto it = source.begin(); it != source.end(); it++) {
+            node child;
+            child.label = static_cast<std::uint32_t>(m_labels.size());
+            m_labels += it->first;
+            const dfa_tree<char>::node_t *last = &it->second;
+            while(last->number_of_children() == 1) {
+                m_labels += last->begin()->first;
+                last = &last->begin()->second;
+            }
+            child.label_length = static_cast<std::uint32_t>(m_labels.size() - child.label);
+            pending.push_back(std::make_pair(static_cast<std::uint32_t>(m_nodes.size()), last));
+            m_nodes.push_back(child);
+            m_first_chars.push_back(it->first);
+        }
+    }
+    m_nodes.shrink_to_fit();
+    m_first_chars.shrink_to_fit();
+    m_labels.shrink_to_fit();
+}
+
+bool dfa_radix_tree::contains_string(const std::string &str) const
+{
+    const std::string &s = str + m_end_marker;
+    const char *s_it = s.data();
+    const char *s_end = s_it + s.length();
+    const node *current = &m_nodes[0];
+    while(s_it != s_end) {
+        const std::uint32_t child = child_id(*current, *s_it);
+        if(!child) {
+            return false;
+        }
+        current = &m_nodes[child];
+        if(current->label_length > static_cast<size_t>(s_end - s_it)
+            || std::memcmp(m_labels.data() + current->label, s_it, current->label_length) != 0) {
+            return false;
+        }
+        s_it += current->label_length;
+    }
+    return true;
+}
+
+bool dfa_radix_tree::match_allow_substitution(
+    const std::string &str,
+    unsigned int subst_max,
+    std::string &matched,
+    unsigned int &cost
+) const
+{
+    // Same logic as dfa_string_dict::search_allow_substitution(), reading the
+    // characters of a label one after the other. Nodes are visited depth
+    // first, each unvisited node being stored with the length of the string
+    // read before its label and the substitutions used to read it. That string
+    // is held by the first characters of path, which are not overwritten
+    // until all the nodes below it have been visited.
+
+    typedef unsigned int uint;
+
+    const std::string &s = str + m_end_marker;
+    const uint s_len = s.length();
+
+    struct entry { std::uint32_t node_id; uint depth; uint cost; };
+    std::vector<entry> unvisited_nodes;
+    const node &root = m_nodes[0];
+    for(std::uint32_t child = root.first_child; child < root.first_child + root.child_count; child++) {
+        unvisited_nodes.push_back({child, 0, 0});
+    }
+    std::string path;
+
+    while(!unvisited_nodes.empty()) {
+        const entry curr = unvisited_nodes.back();
+        unvisited_nodes.pop_back();
+        const node &curr_node = m_nodes[curr.node_id];
+        const char *label = m_labels.data() + curr_node.label;
+        if(curr.depth + curr_node.label_length > s_len) {
+            continue; // the tree strings read from here are longer than s
+        }
+
+        uint curr_cost = curr.cost;
+        uint depth = curr.depth;
+        for(uint i = 0; i < curr_node.label_length && curr_cost <= subst_max; i++, depth++) {
+            // The end of string marker is never substituted.
+            curr_cost += label[i] == s[depth] ? 0
+                       : depth + 1 == s_len ? subst_max + 1 : 1;
+        }
+        if(curr_cost > subst_max) {
+            continue;
+        }
+
+        path.resize(curr.depth);
+        path.append(label, curr_node.label_length);
+        if(depth == s_len) {
+            // Only the labels of leaves end with the end of string marker.
+            matched = path.substr(0, path.length() - 1);
+            cost = curr_cost;
+            return true;
+        }
+        for(std::uint32_t child = curr_node.first_child;
+            child < curr_node.first_child + curr_node.child_count; child++) {
+            unvisited_nodes.push_back({child, depth, curr_cost});
+        }
+    }
+    return false;
+}
+
+bool dfa_radix_tree::match_levenshtein_distance(
+    const std::string &str,
+    unsigned int edit_max,
+    std::string &matched,
+    unsigned int &cost
+) const
+{
+    // Same logic as dfa_string_dict::search_levenshtein_distance(), nodes
+    // being visited as in match_allow_substitution(). The rows of the
+    // Levenshtein distance matrix are stored one after the other in rows, row
+    // d being the row after reading d characters, so the rows of a label are
+    // computed in a single pass from the last row of its parent, which is
+    // still there.
+
+    typedef unsigned int uint;
+
+    const std::string &s = str + m_end_marker;
+    const uint row_size = s.length() + 1;
+
+    std::vector<uint> rows(row_size);
+    for(uint i = 0; i < row_size; i++) {
+        rows[i] = i;
+    }
+
+    struct entry { std::uint32_t node_id; uint depth; };
+    std::vector<entry> unvisited_nodes;
+    const node &root = m_nodes[0];
+    for(std::uint32_t child = root.first_child; child < root.first_child + root.child_count; child++) {
+        unvisited_nodes.push_back({child, 0});
+    }
+    std::string path;
+
+    while(!unvisited_nodes.empty()) {
+        const entry curr = unvisited_nodes.back();
+        unvisited_nodes.pop_back();
+        const node &curr_node = m_nodes[curr.node_id];
+        const char *label = m_labels.data() + curr_node.label;
+        const size_t rows_size_min = (curr.depth + curr_node.label_length + 1) * row_size;
+        if(rows.size() < rows_size_min) {
+            rows.resize(rows_size_min);
+        }
+
+        uint depth = curr.depth;
+        bool pruned = false;
+        for(uint i = 0; i < curr_node.label_length && !pruned; i++, depth++) {
+            const uint *prev_row = rows.data() + depth * row_size;
+            uint *curr_row = rows.data() + (depth + 1) * row_size;
+            const char c = label[i];
+            curr_row[0] = prev_row[0] + 1;
+            uint row_min = curr_row[0];
+            for(uint j = 1; j < row_size; j++) {
+                curr_row[j] = std::min({
+                    curr_row[j-1] + 1, // insertion cost
+                    prev_row[j] + 1, // deletion cost
+                    prev_row[j-1] + (c == s[j-1] ? 0 : 1), // substitution cost
+                });
+                row_min = std::min(row_min, curr_row[j]);
+            }
+
+            if(c == m_end_marker && curr_row[row_size-1] <= edit_max) {
+                path.resize(curr.depth);
+                path.append(label, i);
+                matched = path;
+                cost = curr_row[row_size-1];
+                return true;
+            }
+            pruned = row_min > edit_max;
+        }
+        if(pruned) {
+            continue;
+        }
+
+        path.resize(curr.depth);
+        path.append(label, curr_node.label_length);
+        for(std::uint32_t child = curr_node.first_child;
+            child < curr_node.first_child + curr_node.child_count; child++) {
+            unvisited_nodes.push_back({child, depth});
+        }
+    }
+    return false;
+}
+
+size_t dfa_radix_tree::approximate_memory_usage() const
+{
+    return sizeof(*this)
+         + m_nodes.capacity() * sizeof(node)
+         + m_first_chars.capacity()
+         + m_labels.capacity();
+}
+
+std::uint32_t dfa_radix_tree::child_id(const node &parent, char c) const
+{
+    const auto begin = m_first_chars.begin() + parent.first_child;
+    const auto end = begin + parent.child_count;
+    const auto it = std::lower_bound(begin, end, c);
+    return it != end && *it == c ? static_cast<std::uint32_t>(it - m_first_chars.begin()) : 0;
+}
@@ -0,0 +1,99 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef DFA_RADIX_TREE_H
+#define DFA_RADIX_TREE_H
+
+#include "dfa_tree.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// A path-compressed (radix or Patricia) copy of a character tree such as the
+/// one of dfa_string_dict, in which every chain of single-child nodes is
+/// collapsed into one node labeled with the characters read along the chain.
+/// Below the first levels of a dictionary tree, most nodes have exactly one
+/// child, so each string mostly ends in a single node.
+///
+/// Nodes are stored in an array in breadth-first order, the children of a node
+/// being consecutive and sorted by the first character of their label, and
+/// labels are stored back to back in a single string (label pool). Exact
+/// matching compares whole labels using memcmp(), and fuzzy matching computes
+/// the matrix rows of a label one after the other before visiting the children
+/// of its node.
+///
+/// The tree is a snapshot: strings added to the source tree afterwards are not
+/// found until it is built again.
+class dfa_radix_tree
+{
+public:
+    /// Builds the radix tree of tree, whose strings end with end_marker.
+    explicit dfa_radix_tree(const dfa_tree<char> &tree, char end_marker);
+
+    /// Returns whether str (without end marker) is a string of this tree.
+    bool contains_string(const std::string &str) const;
+
+    /// Searches for a string of this tree requiring at most subst_max
+    /// substitutions of str. On success, matched is set to the string found
+    /// (without end marker) and cost to the number of substitutions.
+    bool match_allow_substitution(const std::string &str,
+                                  unsigned int subst_max,
+                                  std::string &matched,
+                                  unsigned int &cost) const;
+
+    /// Same as above allowing edit_max edits (Levenshtein distance).
+    bool match_levenshtein_distance(const std::string &str,
+                                    unsigned int edit_max,
+                                    std::string &matched,
+                                    unsigned int &cost) const;
+
+    /// Returns the number of nodes, root node excluded.
+    size_t number_of_nodes() const { return m_nodes.size() - 1; }
+
+    /// Returns an estimate of the memory used by this tree in bytes.
+    size_t approximate_memory_usage() const;
+
+private:
+    struct node {
+        std::uint32_t label {0};        // offset of the label in m_labels
+        std::uint32_t label_length {0};
+        std::uint32_t first_child {0};
+        std::uint32_t child_count {0};
+    };
+
+    /// Returns the child of a node whose label starts with c, or 0 (the root
+    /// node is nobody's child).
+    std::uint32_t child_id(const node &parent, char c) const;
+
+private:
+    char m_end_marker;
+    std::vector<node> m_nodes;       // nodes in breadth-first order, root node first
+    std::vector<char> m_first_chars; // first character of the label of each node
+    std::string m_labels;            // label pool
+};
+
+#endif // DFA_RADIX_TREE_H
@@ -26,11 +26,16 @@
 
 #include "dfa_string_dict.h"
 
+#include "csv_parser.h"
+#include "dfa_matcher.hpp"
 #include "dfa_tree_utils.hpp"
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <stack>
+#include <tuple>
 
 // a special character which cannot be added as a string to the dictionary
 const char dfa_string_dict::tree_end_of_string_marker {'$'};
@@ -41,17 +46,44 @@ dfa_string_dict::dfa_string_dict()
 
 bool dfa_string_dict::add_string(const std::string &str)
 {
-    if(str.find(dfa_string_dict::tree_end_of_string_marker) != std::string::npos) {
+    return add_string(str.data(), str.length());
+}
+
+bool dfa_string_dict::add_string(const char *str, size_t length)
+{
+    if(std::memchr(str, dfa_string_dict::tree_end_of_string_marker, length)) {
         return false; // string must not contain tree_end_of_string_marker
     }
 
     dfa_tree<char>::node_t *node = &m_tree.root();
-    for(const char c : str + dfa_string_dict::tree_end_of_string_marker) {
-        node = &node->set_child(c);
+    for(size_t i = 0; i < length; i++) {
+        node = &node->set_child(str[i]);
+    }
+    if(!node->child_ptr(dfa_string_dict::tree_end_of_string_marker)) {
+        node->set_child(dfa_string_dict::tree_end_of_string_marker);
+        m_exact_filter.reset();
+        if(m_reverse_tree || m_qgram_index) {
+            const std::string copy(str, length);
+            if(m_reverse_tree) {
+                add_reversed_string(copy);
+            }
+            if(m_qgram_index) {
+                m_qgram_index->add_string(copy); // only new strings are indexed
+            }
+        }
     }
     return true;
 }
 
+void dfa_string_dict::add_reversed_string(const std::string &str)
+{
+    dfa_tree<char>::node_t *node = &m_reverse_tree->root();
+    for(auto it = str.rbegin(); it != str.rend(); it++) {
+        node = &node->set_child(*it);
+    }
+    node->set_child(dfa_string_dict::tree_end_of_string_marker);
+}
+
 bool dfa_string_dict::add_strings_from_file(const std::string &filename)
 {
     std::ifstream file(filename);
@@ -68,9 +100,124 @@ bool dfa_string_dict::add_strings_from_file(const std::string &filename)
     return true;
 }
 
+bool dfa_string_dict::add_strings_from_csv(
+    const std::string &filename,
+    const csv_columns &columns
+)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if(!file.is_open()) {
+        return false;
+    }
+
+    const bool weighted = columns.weight_column >= 0;
+    const size_t weight_column = weighted ? static_cast<size_t>(columns.weight_column) : 0;
+    const size_t field_count_min = std::max(columns.string_column, weight_column) + 1;
+    std::string weight_str;
+    csv_parser parser([&](const csv_record &record) {
+        if((columns.header && record.index == 0) || record.size() < field_count_min) {
+            return;
+        }
+        if(weighted) {
+            // strtod() needs a null-terminated string.
+            const csv_field_view &weight_field = record[weight_column];
+            weight_str.assign(weight_field.data, weight_field.size);
+            char *weight_end = nullptr;
+            const double weight = std::strtod(weight_str.c_str(), &weight_end);
+            if(weight_str.empty() || *weight_end != '\0' || !(weight >= columns.min_weight)) {
+                return;
+            }
+        }
+        const csv_field_view &field = record[columns.string_column];
+        add_string(field.data, field.size);
+    });
+
+    std::vector<char> chunk(1 << 20);
+    while(file) {
+        file.read(chunk.data(), chunk.size());
+        parser.parse(chunk.data(), static_cast<size_t>(file.gcount()));
+    }
+    parser.end();
+    return true;
+}
+
 void dfa_string_dict::clear()
 {
     m_tree.clear();
+    if(m_reverse_tree) {
+        m_reverse_tree->clear();
+    }
+    if(m_qgram_index) {
+        m_qgram_index->clear();
+    }
+    m_exact_filter.reset();
+}
+
+void dfa_string_dict::enable_qgram_index(
+    unsigned int q,
+    unsigned int crossover_cost_max
+)
+{
+    m_qgram_index.reset(
+        new qgram_index(q, dfa_string_dict::tree_end_of_string_marker)
+    );
+    m_qgram_crossover_cost_max = crossover_cost_max;
+
+    gather_strings([this](const std::string &str) {
+        // remove tree_end_of_string_marker
+        m_qgram_index->add_string(str.substr(0, str.length() - 1));
+    });
+}
+
+void dfa_string_dict::disable_qgram_index()
+{
+    m_qgram_index.reset();
+}
+
+void dfa_string_dict::enable_bidirectional_search()
+{
+    m_reverse_tree.reset(new dfa_tree<char>());
+
+    gather_strings([this](const std::string &str) {
+        // remove tree_end_of_string_marker
+        add_reversed_string(str.substr(0, str.length() - 1));
+    });
+}
+
+void dfa_string_dict::disable_bidirectional_search()
+{
+    m_reverse_tree.reset();
+}
+
+void dfa_string_dict::enable_exact_filter(unsigned int bloom_bits_per_string)
+{
+    std::vector<std::string> strings;
+    gather_strings([&strings](const std::string &str) {
+        // remove tree_end_of_string_marker
+        strings.push_back(str.substr(0, str.length() - 1));
+    });
+    m_exact_filter.reset(new exact_match_filter(strings, bloom_bits_per_string));
+}
+
+void dfa_string_dict::disable_exact_filter()
+{
+    m_exact_filter.reset();
+}
+
+bool dfa_string_dict::contains_string(const std::string &str) const
+{
+    if(m_exact_filter) {
+        return m_exact_filter->contains(str);
+    }
+
+    const dfa_tree<char>::node_t *node = &m_tree.root();
+    for(const char c : str) {
+        node = node->child_ptr(c);
+        if(!node) {
+            return false;
+        }
+    }
+    return node->child_ptr(dfa_string_dict::tree_end_of_string_marker) != nullptr;
 }
 
 dfa_string_dict::match_result dfa_string_dict::match_string_exactly(
@@ -82,6 +229,24 @@ dfa_string_dict::match_result dfa_string_dict::match_string_exactly(
     //        tree_end_of_string_marker) or failure (at least one character
     //        cannot be read).
 
+    if(m_exact_filter) {
+        // The filter does not tell where the string stops matching.
+        dfa_string_dict::match_result match;
+        match.setData(
+            "exact-filter-match",
+            str,
+            m_exact_filter->contains(str),
+            [&]() { return "\"" + str + dfa_string_dict::tree_end_of_string_marker
+                         + "\" matched successfully"; },
+            [&]() { return "\"" + str + dfa_string_dict::tree_end_of_string_marker
+                         + "\" failed to match"; }
+        );
+        if(match.success) {
+            match.setMatched(str, 0);
+        }
+        return match;
+    }
+
     typedef unsigned int uint;
 
     const std::string &s = str + dfa_string_dict::tree_end_of_string_marker;
@@ -107,6 +272,9 @@ dfa_string_dict::match_result dfa_string_dict::match_string_exactly(
                      + s.at(s_nb_chars_read) + "' after reading \""
                      + s.substr(0, s_nb_chars_read) + "\" successfully"; }
     );
+    if(match.success) {
+        match.setMatched(str, 0);
+    }
     return match;
 }
 
@@ -114,31 +282,230 @@ dfa_string_dict::match_result dfa_string_dict::match_string_allow_substitution(
     const std::string &str,
     unsigned int subst_max
 ) const
+{
+    return match_allow_substitution(str, subst_max, nullptr);
+}
+
+dfa_string_dict::match_result dfa_string_dict::match_string_allow_substitution(
+    const std::string &str,
+    unsigned int subst_max,
+    const search_limits &limits
+) const
+{
+    search_budget budget(limits);
+    return match_allow_substitution(str, subst_max, &budget);
+}
+
+dfa_string_dict::match_result dfa_string_dict::match_allow_substitution(
+    const std::string &str,
+    unsigned int subst_max,
+    search_budget *budget
+) const
+{
+    if(use_qgram_index(subst_max)) {
+        return match_string_using_qgram_index(str, subst_max, true, budget);
+    }
+
+    const std::string &s = str + dfa_string_dict::tree_end_of_string_marker;
+    bool s_matched {false};
+    std::string s_matched_string;
+    unsigned int s_matched_string_cost {0};
+    std::string algorithm {"subst-match"};
+
+    if(use_reverse_tree(subst_max)) {
+        // The head of the given string is matched in the character tree using
+        // at most head_subst_max substitutions, and its tail in the reverse
+        // character tree using at most tail_subst_max substitutions; the total
+        // remains bounded by subst_max in both cases. A string requiring at
+        // most subst_max substitutions cannot exceed both budgets, so it is
+        // necessarily found by one of the two searches.
+        const unsigned int head_length = str.length() / 2;
+        const unsigned int head_subst_max = subst_max / 2;
+        const unsigned int tail_subst_max = subst_max - head_subst_max - 1;
+        const std::string &rs = reversed_string(str)
+                              + dfa_string_dict::tree_end_of_string_marker;
+
+        s_matched = search_allow_substitution(
+            m_tree, s, subst_max, head_length, head_subst_max,
+            s_matched_string, s_matched_string_cost, budget
+        );
+        if(!s_matched && head_length > 0
+        && !(budget && budget->exhausted)) {
+            if(budget) {
+                budget->reverse_tree = true;
+            }
+            s_matched = search_allow_substitution(
+                *m_reverse_tree, rs, subst_max, str.length() - head_length,
+                tail_subst_max, s_matched_string, s_matched_string_cost, budget
+            );
+            s_matched_string = unreversed_tree_string(s_matched_string);
+        }
+        algorithm = "subst-bidir-match";
+    }
+    else if(budget
+         || !dfa_matcher_dispatch::match<substitution_match_policy>(
+                m_tree.root(), s, dfa_string_dict::tree_end_of_string_marker,
+                subst_max, s_matched, s_matched_string, s_matched_string_cost)) {
+        // The cost is too large for the compile-time specialized algorithms,
+        // or the search must be bounded, which they do not support.
+        s_matched = search_allow_substitution(
+            m_tree, s, subst_max, 0, subst_max,
+            s_matched_string, s_matched_string_cost, budget
+        );
+    }
+
+    dfa_string_dict::match_result match;
+    match.setData(
+        algorithm + "(" + std::to_string(subst_max) + ")",
+        str,
+        s_matched,
+        [&]() { return "\"" + s + "\" matched successfully with \""
+                      + s_matched_string + "\" using "
+                      + std::to_string(s_matched_string_cost) + " substs"; },
+        [&]() { return "\"" + s + "\" failed to match"; }
+    );
+    if(s_matched) {
+        match.setMatched(
+            s_matched_string.substr(0, s_matched_string.length() - 1),
+            s_matched_string_cost
+        );
+    }
+    set_incomplete(match, budget, "node expansions", "substs");
+    return match;
+}
+
+dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance(
+    const std::string &str,
+    unsigned int edit_max
+) const
+{
+    return match_levenshtein_distance(str, edit_max, nullptr);
+}
+
+dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance(
+    const std::string &str,
+    unsigned int edit_max,
+    const search_limits &limits
+) const
+{
+    search_budget budget(limits);
+    return match_levenshtein_distance(str, edit_max, &budget);
+}
+
+dfa_string_dict::match_result dfa_string_dict::match_levenshtein_distance(
+    const std::string &str,
+    unsigned int edit_max,
+    search_budget *budget
+) const
+{
+    if(use_qgram_index(edit_max)) {
+        return match_string_using_qgram_index(str, edit_max, false, budget);
+    }
+
+    const std::string &s = str + dfa_string_dict::tree_end_of_string_marker;
+    bool s_matched {false};
+    std::string s_matched_string;
+    unsigned int s_matched_string_cost {0};
+    std::string algorithm {"leven-match"};
+
+    if(use_reverse_tree(edit_max)) {
+        // Same as in match_string_allow_substitution(), which is possible
+        // because if a string w is such that Lev(str, w) <= edit_max, then w
+        // can be split into w1 and w2 such that:
+        //     Lev(head, w1) + Lev(tail, w2) <= edit_max
+        // where head and tail are the two halves of str.
+        const unsigned int head_length = str.length() / 2;
+        const unsigned int head_edit_max = edit_max / 2;
+        const unsigned int tail_edit_max = edit_max - head_edit_max - 1;
+        const std::string &rs = reversed_string(str)
+                              + dfa_string_dict::tree_end_of_string_marker;
+
+        s_matched = search_levenshtein_distance(
+            m_tree, s, edit_max, head_length, head_edit_max,
+            s_matched_string, s_matched_string_cost, budget
+        );
+        if(!s_matched && head_length > 0
+        && !(budget && budget->exhausted)) {
+            if(budget) {
+                budget->reverse_tree = true;
+            }
+            s_matched = search_levenshtein_distance(
+                *m_reverse_tree, rs, edit_max, str.length() - head_length,
+                tail_edit_max, s_matched_string, s_matched_string_cost, budget
+            );
+            s_matched_string = unreversed_tree_string(s_matched_string);
+        }
+        algorithm = "leven-bidir-match";
+    }
+    else if(budget
+         || !dfa_matcher_dispatch::match<levenshtein_match_policy>(
+                m_tree.root(), s, dfa_string_dict::tree_end_of_string_marker,
+                edit_max, s_matched, s_matched_string, s_matched_string_cost)) {
+        // The cost is too large for the compile-time specialized algorithms,
+        // or the search must be bounded, which they do not support.
+        s_matched = search_levenshtein_distance(
+            m_tree, s, edit_max, 0, edit_max,
+            s_matched_string, s_matched_string_cost, budget
+        );
+    }
+
+    dfa_string_dict::match_result match;
+    match.setData(
+        algorithm + "(" + std::to_string(edit_max) + ")",
+        str,
+        s_matched,
+        [&]() { return "\"" + s + "\" matched successfully with \""
+                     + s_matched_string + "\" using "
+                     + std::to_string(s_matched_string_cost) + " edits"; },
+        [&]() { return "\"" + s + "\" failed to match"; }
+    );
+    if(s_matched) {
+        match.setMatched(
+            s_matched_string.substr(0, s_matched_string.length() - 1),
+            s_matched_string_cost
+        );
+    }
+    set_incomplete(match, budget, "node expansions", "edits");
+    return match;
+}
+
+bool dfa_string_dict::search_allow_substitution(
+    const dfa_tree<char> &tree,
+    const std::string &s,
+    unsigned int subst_max,
+    unsigned int head_length,
+    unsigned int head_subst_max,
+    std::string &s_matched_string,
+    unsigned int &s_matched_string_cost,
+    search_budget *budget
+)
 {
     // Logic: we compute the number of substitutions required to reach each node
     //        in the character tree, yielding success when a string matching the
     //        given substitution criteria is found, or failure when no such
     //        string exists. Computation starts at the root node and is
-    //        initialized with a substitution count of 0.
+    //        initialized with a substitution count of 0. Nodes reached with too
+    //        many substitutions are not visited any further.
 
     typedef unsigned int uint;
 
-    const std::string &s = str + dfa_string_dict::tree_end_of_string_marker;
     const uint s_len = s.length();
     bool s_matched {false};
-    std::string s_matched_string;
-    uint s_matched_string_cost {0};
 
     // Set the first tree node to visit.
     std::stack<
             std::tuple<const dfa_tree<char>::node_t*, std::string, uint, uint>
             > unvisited_nodes;
     unvisited_nodes.push(
-        std::make_tuple(&m_tree.root(), "", 0, 0)
+        std::make_tuple(&tree.root(), "", 0, 0)
     );
 
     // Start visiting.
     while(!s_matched && !unvisited_nodes.empty()) {
+        if(budget && !budget->spend()) {
+            break;
+        }
+
         // Select one tree node to visit.
         const dfa_tree<char>::node_t* prev_node;
         std::string prev_read_string;
@@ -158,60 +525,60 @@ dfa_string_dict::match_result dfa_string_dict::match_string_allow_substitution(
             const uint curr_nb_chars_read = prev_nb_chars_read + 1;
 
             // Decide whether a substitution is required.
-            if(expected_char == it->first) {
-                if(curr_nb_chars_read == s_len) {
-                    if(prev_subst_cost <= subst_max) {
-                        s_matched = true;
-                        s_matched_string = curr_read_string;
-                        s_matched_string_cost = prev_subst_cost;
-                        break;
-                    }
-                }
-                else {
-                    if(curr_nb_chars_read < s_len) {
-                        unvisited_nodes.push(
-                            std::make_tuple(
-                                &it->second,
-                                curr_read_string,
-                                curr_nb_chars_read,
-                                prev_subst_cost // 0 substitution needed
-                            )
-                        );
-                    }
+            const uint curr_subst_cost = prev_subst_cost
+                                       + (expected_char == it->first ? 0 : 1);
+
+            if(curr_nb_chars_read == s_len) {
+                if(expected_char == it->first && curr_subst_cost <= subst_max) {
+                    s_matched = true;
+                    s_matched_string = curr_read_string;
+                    s_matched_string_cost = curr_subst_cost;
+                    break;
                 }
             }
             else {
-                if(curr_nb_chars_read < s_len) {
+                // Save the tree node for later if the substitution budget
+                // applicable to the characters read so far is not exceeded.
+                const uint curr_subst_max = curr_nb_chars_read <= head_length
+                                          ? head_subst_max
+                                          : subst_max;
+                if(curr_subst_cost <= curr_subst_max) {
                     unvisited_nodes.push(
                         std::make_tuple(
                             &it->second,
                             curr_read_string,
                             curr_nb_chars_read,
-                            prev_subst_cost + 1 // 1 substitution needed
+                            curr_subst_cost
                         )
                     );
                 }
+                else if(budget && curr_nb_chars_read == s_len - 1
+                     && curr_subst_cost > subst_max
+                     && it->second.child_ptr(dfa_string_dict::tree_end_of_string_marker)) {
+                    // A string of the same length as the given one, beyond
+                    // the substitution budget.
+                    budget->offer(
+                        curr_read_string + dfa_string_dict::tree_end_of_string_marker,
+                        curr_subst_cost
+                    );
+                }
             }
         }
     }
 
-    dfa_string_dict::match_result match;
-    match.setData(
-        "subst-match(" + std::to_string(subst_max) + ")",
-        str,
-        s_matched,
-        [&]() { return "\"" + s + "\" matched successfully with \""
-                      + s_matched_string + "\" using "
-                      + std::to_string(s_matched_string_cost) + " substs"; },
-        [&]() { return "\"" + s + "\" failed to match"; }
-    );
-    return match;
+    return s_matched;
 }
 
-dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance(
-    const std::string &str,
-    unsigned int edit_max
-) const
+bool dfa_string_dict::search_levenshtein_distance(
+    const dfa_tree<char> &tree,
+    const std::string &s,
+    unsigned int edit_max,
+    unsigned int head_length,
+    unsigned int head_edit_max,
+    std::string &s_matched_string,
+    unsigned int &s_matched_string_cost,
+    search_budget *budget
+)
 {
     // Logic: we compute the Levenshtein distance from all strings in the
     //        character tree to the given string, yielding success when we reach
@@ -247,14 +614,17 @@ dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance
     // This is how we will compute the Levenshtein distance from any string in
     // the character tree to the given string, starting from the first character
     // in the tree down to the leaf nodes.
+    //
+    // When a head length is given, the first head_length characters of the
+    // given string must be matched by a prefix of the tree string using at
+    // most head_edit_max edits: until this happens, a tree node is only worth
+    // visiting if one of the first head_length + 1 values in its row does not
+    // exceed head_edit_max.
 
     typedef unsigned int uint;
     typedef std::vector<uint> uint_vector;
 
-    const std::string &s = str + dfa_string_dict::tree_end_of_string_marker;
     bool s_matched {false};
-    std::string s_matched_string;
-    uint s_matched_string_cost {0};
 
     uint_vector s_lev_row; // first row in Levenshtein distance matrix
     const uint s_lev_row_size = s.length() + 1;
@@ -262,23 +632,30 @@ dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance
         s_lev_row.push_back(i);
     }
 
-    // Set the first tree node to visit.
+    // Set the first tree node to visit. The last element in the tuple tells
+    // whether the head of the given string has been matched.
     std::stack<
-            std::tuple<const dfa_tree<char>::node_t*, std::string, uint_vector>
+            std::tuple<const dfa_tree<char>::node_t*, std::string, uint_vector, bool>
             > unvisited_nodes;
     unvisited_nodes.push(
-        std::make_tuple(&m_tree.root(), "", s_lev_row)
+        std::make_tuple(&tree.root(), "", s_lev_row, head_length <= head_edit_max)
     );
 
     // Start visiting.
     while(!s_matched && !unvisited_nodes.empty()) {
+        if(budget && !budget->spend()) {
+            break;
+        }
+
         // Select one tree node to visit.
         const dfa_tree<char>::node_t* prev_node;
         std::string prev_read_string;
         uint_vector prev_lev_row;
+        bool prev_head_matched;
         std::tie(prev_node,
                  prev_read_string,
-                 prev_lev_row) = unvisited_nodes.top();
+                 prev_lev_row,
+                 prev_head_matched) = unvisited_nodes.top();
         unvisited_nodes.pop();
 
         const uint prev_lev_row_size = prev_lev_row.size();
@@ -308,21 +685,33 @@ dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance
                 s_matched_string = curr_read_string;
                 s_matched_string_cost = curr_lev_row_goal_cost;
             }
+            else if(budget
+                 && it->first == dfa_string_dict::tree_end_of_string_marker) {
+                budget->offer(curr_read_string, curr_lev_row_goal_cost);
+            }
 
             // Save the tree node for later if the maximum edit cost has not
             // been exceeded. Indeed, next time we will be adding either 0 or
             // 1 to the costs in the current row of the computed Levenshtein
-            // distance matrix.
-            const uint curr_lev_row_min_cost = *std::min_element(
-                curr_lev_row.begin(),
-                curr_lev_row.end()
-            );
-            if(curr_lev_row_min_cost <= edit_max) {
+            // distance matrix. The same applies to the head of the given
+            // string if it has not been matched yet.
+            const bool curr_head_matched = prev_head_matched
+                || curr_lev_row.at(head_length) <= head_edit_max;
+            const uint curr_lev_row_min_cost = curr_head_matched
+                ? *std::min_element(curr_lev_row.begin(),
+                                    curr_lev_row.end())
+                : *std::min_element(curr_lev_row.begin(),
+                                    curr_lev_row.begin() + head_length + 1);
+            const uint curr_lev_row_max_cost = curr_head_matched
+                ? edit_max
+                : head_edit_max;
+            if(curr_lev_row_min_cost <= curr_lev_row_max_cost) {
                 unvisited_nodes.push(
                     std::make_tuple(
                         &it->second,
                         curr_read_string,
-                        curr_lev_row
+                        curr_lev_row,
+                        curr_head_matched
                     )
                 );
             }
@@ -334,16 +723,136 @@ dfa_string_dict::match_result dfa_string_dict::match_string_levenshtein_distance
         }
     }
 
+    return s_matched;
+}
+
+bool dfa_string_dict::search_budget::spend()
+{
+    // The clock is only read every 64 node expansions, which costs little
+    // compared with expanding them.
+    node_expansions++;
+    if((limits.node_expansion_max != 0
+        && node_expansions > limits.node_expansion_max)
+    || (node_expansions % 64 == 1
+        && limits.deadline != std::chrono::steady_clock::time_point::max()
+        && std::chrono::steady_clock::now() >= limits.deadline)) {
+        exhausted = true;
+    }
+    return !exhausted;
+}
+
+void dfa_string_dict::search_budget::offer(const std::string &tree_string,
+                                           unsigned int cost)
+{
+    if(!has_closest || cost < closest_string_cost) {
+        has_closest = true;
+        closest_string = reverse_tree ? unreversed_tree_string(tree_string)
+                                      : tree_string;
+        closest_string_cost = cost;
+    }
+}
+
+void dfa_string_dict::set_incomplete(match_result &match,
+                                     const search_budget *budget,
+                                     const std::string &work,
+                                     const std::string &unit)
+{
+    if(!budget || !budget->exhausted) {
+        return;
+    }
+    match.complete = false;
+    match.message += " (search stopped after "
+                   + std::to_string(budget->node_expansions - 1)
+                   + " " + work + ")";
+    if(budget->has_closest) { // exhausted searches do not succeed
+        const std::string &closest = budget->closest_string;
+        match.setMatched(closest.substr(0, closest.length() - 1),
+                         budget->closest_string_cost);
+        match.message += ", closest string found is \"" + closest
+                       + "\" using " + std::to_string(match.cost) + " " + unit;
+    }
+}
+
+bool dfa_string_dict::use_reverse_tree(unsigned int cost_max) const
+{
+    // With no cost allowed, splitting the given string is useless.
+    return m_reverse_tree && cost_max > 0;
+}
+
+std::string dfa_string_dict::reversed_string(const std::string &str)
+{
+    return std::string(str.rbegin(), str.rend());
+}
+
+std::string dfa_string_dict::unreversed_tree_string(const std::string &str)
+{
+    // Strings read from the reverse character tree end with the
+    // tree_end_of_string_marker, which must stay at the end.
+    if(str.empty()) {
+        return str;
+    }
+    return reversed_string(str.substr(0, str.length() - 1)) + str.back();
+}
+
+bool dfa_string_dict::use_qgram_index(unsigned int cost_max) const
+{
+    return m_qgram_index && cost_max >= m_qgram_crossover_cost_max;
+}
+
+dfa_string_dict::match_result dfa_string_dict::match_string_using_qgram_index(
+    const std::string &str,
+    unsigned int cost_max,
+    bool substitution_only,
+    search_budget *budget
+) const
+{
+    // Logic: the q-gram index shortlists the strings sharing enough q-grams
+    //        with the given string and verifies them only, instead of visiting
+    //        the character tree. Besides, the closest string is returned rather
+    //        than the first one found. A bounded search spends one unit of
+    //        budget per verified string.
+
+    const std::string &s = str + dfa_string_dict::tree_end_of_string_marker;
+    std::string s_matched_string;
+    unsigned int s_matched_string_cost {0};
+
+    qgram_index::verification_budget verification_budget;
+    if(budget) {
+        verification_budget.spend = [budget]() { return budget->spend(); };
+        verification_budget.offer = [budget](const std::string &candidate, unsigned int cost) {
+            budget->offer(candidate + dfa_string_dict::tree_end_of_string_marker, cost);
+        };
+    }
+    const qgram_index::verification_budget *index_budget
+        = budget ? &verification_budget : nullptr;
+
+    const bool s_matched = substitution_only
+        ? m_qgram_index->find_allow_substitution(
+              str, cost_max, s_matched_string, s_matched_string_cost, index_budget)
+        : m_qgram_index->find_levenshtein_distance(
+              str, cost_max, s_matched_string, s_matched_string_cost, index_budget);
+    s_matched_string += dfa_string_dict::tree_end_of_string_marker;
+
+    const std::string &algorithm = substitution_only ? "subst" : "leven";
+    const std::string &unit = substitution_only ? "substs" : "edits";
+
     dfa_string_dict::match_result match;
     match.setData(
-        "leven-match(" + std::to_string(edit_max) + ")",
+        algorithm + "-qgram-match(" + std::to_string(cost_max) + ")",
         str,
         s_matched,
         [&]() { return "\"" + s + "\" matched successfully with \""
                      + s_matched_string + "\" using "
-                     + std::to_string(s_matched_string_cost) + " edits"; },
+                     + std::to_string(s_matched_string_cost) + " " + unit; },
         [&]() { return "\"" + s + "\" failed to match"; }
     );
+    if(s_matched) {
+        match.setMatched(
+            s_matched_string.substr(0, s_matched_string.length() - 1),
+            s_matched_string_cost
+        );
+    }
+    set_incomplete(match, budget, "verified strings", unit);
     return match;
 }
 
@@ -371,7 +880,7 @@ void dfa_string_dict::gather_strings(
 {
     // The algorithm below is recursive but we don't care because this function
     // is provided for debugging purpose only (e.g. print relatively small tree
-    // content).
+    // content). See cursor() otherwise.
 
     for(auto it = node.begin(); it != node.end(); it++) {
         acc += it->first;
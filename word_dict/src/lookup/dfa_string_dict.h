@@ -28,8 +28,16 @@
 #define DFA_STRING_DICT_H
 
 #include "dfa_tree.hpp"
+#include "dfa_tree_cursor.hpp"
+#include "exact_match_filter.h"
+#include "qgram_index.h"
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 /// A dictionary of strings built on top of dfa_tree<char>.
@@ -42,6 +50,9 @@ public:
         std::string source;    // input string used to perform the tree match
         bool success {false};  // indicates whether the input string been matched
         std::string message;   // a status message indicating match success or failure
+        std::string matched;   // string matched in the tree on success (without tree_end_of_string_marker)
+        unsigned int cost {0}; // cost of the match on success
+        bool complete {true};  // false if search_limits stopped the search early (see below)
 
         /// Convenient initialization function to avoid duplicates in source
         /// code.
@@ -63,6 +74,13 @@ public:
             // are more flexible and can encapsulate extra logic.
         }
 
+        /// Sets the string matched in the tree and the cost of the match.
+        void setMatched(const std::string &matched, unsigned int cost)
+        {
+            this->matched = matched;
+            this->cost = cost;
+        }
+
         /// Convenient informative function.
         std::string short_descr() const
         {
@@ -75,6 +93,45 @@ public:
         std::string full_descr() const { return short_descr() + ": " + message; }
     };
 
+    /// Limits bounding the work of a fuzzy string matching algorithm, which
+    /// stops once either of them is reached. The match_result is then
+    /// incomplete: on failure, a string within the allowed cost might exist,
+    /// and matched and cost hold the closest string found so far beyond the
+    /// allowed cost, if any. Substitution searches in the character tree stop
+    /// reading a string as soon as it exceeds the allowed cost, so the closest
+    /// string they find requires exactly one more substitution than allowed.
+    /// Searches using the q-gram index count verified strings as node
+    /// expansions, the closest string being the closest one verified.
+    struct search_limits {
+        /// Time after which the search stops (none by default).
+        std::chrono::steady_clock::time_point deadline {
+            std::chrono::steady_clock::time_point::max()
+        };
+
+        /// Number of tree nodes the search may expand, or of strings the
+        /// q-gram index may verify (0 means no limit).
+        std::uint64_t node_expansion_max {0};
+
+        /// Returns limits whose deadline is the given time from now.
+        static search_limits within(std::chrono::steady_clock::duration time)
+        {
+            search_limits limits;
+            limits.deadline = std::chrono::steady_clock::now() + time;
+            return limits;
+        }
+    };
+
+    /// Cursor over the strings of a dictionary (see cursor()).
+    typedef dfa_tree_cursor<char, std::string> string_cursor;
+
+    /// Columns of a CSV file holding strings (see add_strings_from_csv()).
+    struct csv_columns {
+        size_t string_column {0};  // index of the column holding strings
+        int weight_column {-1};    // index of the column holding weights (-1 if none)
+        double min_weight {0};     // weight below which strings are not added
+        bool header {false};       // whether the first record is a header line to skip
+    };
+
 public:
     explicit dfa_string_dict();
 
@@ -82,12 +139,66 @@ public:
     /// case it contains the tree_end_of_string_marker character.
     bool add_string(const std::string &str);
 
+    /// Same as above for the given number of characters of str.
+    bool add_string(const char *str, size_t length);
+
     /// Adds strings from file using add_string().
     bool add_strings_from_file(const std::string &filename);
 
+    /// Adds strings from a column of a CSV file (RFC 4180) using add_string(),
+    /// directly from the field values of the streaming csv_parser. When a
+    /// weight column is given, records whose weight is not a number or is
+    /// lower than the minimum weight are skipped, as are records too short to
+    /// hold the columns.
+    bool add_strings_from_csv(const std::string &filename,
+                              const csv_columns &columns);
+
     /// Clears this dictionary.
     void clear();
 
+    /// Builds a q-gram index (see qgram_index) over the strings in this
+    /// dictionary, kept up to date by add_string() and clear() afterwards.
+    /// Fuzzy matching algorithms then use the index instead of the character
+    /// tree whenever the allowed cost is at least crossover_cost_max, since
+    /// pruning the tree search becomes ineffective for large costs.
+    void enable_qgram_index(unsigned int q = 2,
+                            unsigned int crossover_cost_max = 3);
+
+    /// Releases the q-gram index, if any.
+    void disable_qgram_index();
+
+    bool has_qgram_index() const { return m_qgram_index != nullptr; }
+
+    /// Builds a reverse character tree holding the reversed strings of this
+    /// dictionary, kept up to date by add_string() and clear() afterwards.
+    /// Fuzzy matching algorithms then split the given string into two halves
+    /// and share the allowed cost between them: one search reads the first
+    /// half from the character tree using at most half of the cost, the other
+    /// reads the second half from the reverse character tree using the
+    /// remaining cost (pigeonhole principle). This limits branching near the
+    /// root nodes, where errors multiply the number of nodes to visit.
+    void enable_bidirectional_search();
+
+    /// Releases the reverse character tree, if any.
+    void disable_bidirectional_search();
+
+    bool has_bidirectional_search() const { return m_reverse_tree != nullptr; }
+
+    /// Builds an exact_match_filter over the strings in this dictionary, which
+    /// contains_string() and match_string_exactly() then use instead of
+    /// reading the character tree. The filter cannot be updated, so
+    /// add_string() releases it when adding a new string, as does clear().
+    void enable_exact_filter(unsigned int bloom_bits_per_string = 10);
+
+    /// Releases the exact match filter, if any.
+    void disable_exact_filter();
+
+    bool has_exact_filter() const { return m_exact_filter != nullptr; }
+
+    /// Returns whether the given string has been added to this dictionary.
+    /// Same as match_string_exactly() without building a match_result.
+    bool contains_string(const std::string &str) const;
+
     /// Exact string matching algorithm.
     ///     - Least permissive.
     ///     - Fastest.
@@ -112,6 +223,124 @@ public:
         unsigned int edit_max = 0
     ) const;
 
+    /// Same as match_string_allow_substitution() but stops once the given
+    /// limits are reached, so that pathological strings (e.g. long strings
+    /// matching nothing) cannot take arbitrarily long.
+    match_result match_string_allow_substitution(
+        const std::string &str,
+        unsigned int subst_max,
+        const search_limits &limits
+    ) const;
+
+    /// Same as above for match_string_levenshtein_distance().
+    match_result match_string_levenshtein_distance(
+        const std::string &str,
+        unsigned int edit_max,
+        const search_limits &limits
+    ) const;
+
+private:
+    /// Work done by a search bounded by search_limits.
+    struct search_budget {
+        explicit search_budget(const search_limits &limits) : limits(limits) {}
+
+        /// Counts one node expansion. Returns false once the limits are
+        /// reached, the clock being read every few expansions only.
+        bool spend();
+
+        /// Keeps the given string read from the tree as the closest one if
+        /// its cost is lower than that of the closest one so far.
+        void offer(const std::string &tree_string, unsigned int cost);
+
+        const search_limits &limits;
+        std::uint64_t node_expansions {0};
+        bool exhausted {false};
+        bool reverse_tree {false};  // whether strings offered are read from the reverse character tree
+        bool has_closest {false};
+        std::string closest_string; // read from the character tree
+        unsigned int closest_string_cost {0};
+    };
+
+    /// Implementation of the fuzzy string matching algorithms, bounded by
+    /// budget unless it is null.
+    match_result match_allow_substitution(
+        const std::string &str,
+        unsigned int subst_max,
+        search_budget *budget
+    ) const;
+    match_result match_levenshtein_distance(
+        const std::string &str,
+        unsigned int edit_max,
+        search_budget *budget
+    ) const;
+
+    /// Sets the fields of match describing an incomplete search, if budget
+    /// was exhausted, work naming what the budget counted and unit the cost.
+    static void set_incomplete(match_result &match,
+                               const search_budget *budget,
+                               const std::string &work,
+                               const std::string &unit);
+
+    void add_reversed_string(const std::string &str);
+
+    /// Returns whether the reverse character tree should be used for the given
+    /// cost.
+    bool use_reverse_tree(unsigned int cost_max) const;
+
+    /// Tree search algorithm behind match_string_allow_substitution(). The
+    /// given string must end with the tree_end_of_string_marker. The first
+    /// head_length characters of the string must be matched using at most
+    /// head_subst_max substitutions, which is ignored when head_length is 0.
+    /// The search stops early once budget, if given, is exhausted.
+    static bool search_allow_substitution(
+        const dfa_tree<char> &tree,
+        const std::string &s,
+        unsigned int subst_max,
+        unsigned int head_length,
+        unsigned int head_subst_max,
+        std::string &s_matched_string,
+        unsigned int &s_matched_string_cost,
+        search_budget *budget = nullptr
+    );
+
+    /// Tree search algorithm behind match_string_levenshtein_distance(). Same
+    /// parameters as in search_allow_substitution() but for edits.
+    static bool search_levenshtein_distance(
+        const dfa_tree<char> &tree,
+        const std::string &s,
+        unsigned int edit_max,
+        unsigned int head_length,
+        unsigned int head_edit_max,
+        std::string &s_matched_string,
+        unsigned int &s_matched_string_cost,
+        search_budget *budget = nullptr
+    );
+
+    static std::string reversed_string(const std::string &str);
+
+    /// Converts a string read from the reverse character tree back to a string
+    /// read from the character tree.
+    static std::string unreversed_tree_string(const std::string &str);
+
+    /// Returns whether the q-gram index should be used for the given cost.
+    bool use_qgram_index(unsigned int cost_max) const;
+
+    match_result match_string_using_qgram_index(
+        const std::string &str,
+        unsigned int cost_max,
+        bool substitution_only,
+        search_budget *budget
+    ) const;
+
+public:
+    /// Returns a cursor enumerating the strings of this dictionary in
+    /// lexicographic order, without recursion nor allocation per string,
+    /// unlike gather_strings(). It must be positioned before use, e.g. using
+    /// first(), seek() or seek_prefix(), and this dictionary must not be
+    /// modified in the meantime.
+    string_cursor cursor() const
+    { return string_cursor(m_tree, dfa_string_dict::tree_end_of_string_marker); }
+
     void gather_strings(std::vector<std::string> &out) const;
     void gather_strings(
         const std::function<void (const std::string &)> &callback
@@ -122,6 +351,17 @@ public:
         const std::function<void (const std::string &)> &callback
     );
 
+    /// Returns the character tree of this dictionary.
+    const dfa_tree<char>& tree() const { return m_tree; }
+
+    /// Returns the reverse character tree of this dictionary, if any (see
+    /// enable_bidirectional_search()).
+    const dfa_tree<char>* reverse_tree() const { return m_reverse_tree.get(); }
+
+    /// Returns the exact match filter of this dictionary, if any (see
+    /// enable_exact_filter()).
+    const exact_match_filter* exact_filter() const { return m_exact_filter.get(); }
+
     void print_strings(std::ostream &stream) const;
     void print_tree(std::ostream &stream) const;
 
@@ -130,6 +370,10 @@ public:
 
 private:
     dfa_tree<char> m_tree;
+    std::unique_ptr<dfa_tree<char>> m_reverse_tree;
+    std::unique_ptr<qgram_index> m_qgram_index;
+    std::unique_ptr<exact_match_filter> m_exact_filter;
+    unsigned int m_qgram_crossover_cost_max {0};
 };
 
 #endif // DFA_STRING_DICT_H
@@ -27,6 +27,7 @@
 #ifndef DFA_TREE_H
 #define DFA_TREE_H
 
+#include <cstddef>
 #include <map>
 
 /// A tree node with possible connections to child nodes. Designed for use with
@@ -38,14 +39,19 @@ private:
     typedef std::map<T, dfa_tree_node> map_t; // data type describing this node's children,
                                               // allowing access and navigation to child nodes
 
+public:
+    typedef typename map_t::const_iterator const_iterator; // iterator over this node's children
+
 public:
     explicit dfa_tree_node() {}
 
     /// Returns a possibly null pointer to a chid of this node.
     const dfa_tree_node* child_ptr(const T &input) const
     {
-        try { return &m_children.at(input); } catch(std::out_of_range &) {}
-        return nullptr;
+        // Avoid std::map::at() here, since throwing and catching an exception
+        // for each missing child is very costly during fuzzy matching.
+        const auto it = m_children.find(input);
+        return it != m_children.end() ? &it->second : nullptr;
     }
 
     /// Returns a possibly null pointer to a chid of this node.
@@ -81,6 +87,10 @@ public:
     /// std::map::end() function to iterate over this node's children.
     typename map_t::const_iterator end() const { return m_children.end(); }
 
+    /// std::map::lower_bound() function to find the first child of this node
+    /// whose input is not lower than the given one.
+    const_iterator lower_bound(const T &input) const { return m_children.lower_bound(input); }
+
 private:
     map_t m_children;
 };
@@ -0,0 +1,213 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef DFA_TREE_CURSOR_H
+#define DFA_TREE_CURSOR_H
+
+#include "dfa_tree.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+/// Cursor enumerating the strings of a dfa_tree in lexicographic order, where
+/// strings are sequences of T read from the root node up to a node having a
+/// child for end_marker, as in dfa_string_dict. T values are compared using
+/// operator<, as in the tree, and a string comes before its extensions. For
+/// char, non-ASCII characters therefore come first where char is signed.
+///
+/// The cursor walks the tree using an explicit stack holding one entry per
+/// character of the current string, and writes the current string into a
+/// buffer of type Word (e.g. std::vector<T> or std::string). Both are reused
+/// from one string to the next and from one seek to the next, so that no
+/// memory is allocated once they have grown to the length of the longest
+/// string.
+///
+/// Typical use:
+///     for(bool ok = cursor.seek_prefix(prefix); ok; ok = cursor.next()) {
+///         use(cursor.word());
+///     }
+///
+/// The tree must not be modified while the cursor is in use.
+template<typename T, typename Word = std::vector<T>>
+class dfa_tree_cursor
+{
+public:
+    typedef dfa_tree_node<T> node_t;
+
+public:
+    explicit dfa_tree_cursor(const dfa_tree<T> &tree, const T &end_marker)
+        : m_tree(tree)
+        , m_end_marker(end_marker)
+    {
+    }
+
+    /// Positions the cursor on the first string of the tree. Returns valid().
+    bool first() { return seek(Word()); }
+
+    /// Positions the cursor on the first string not lower than lower_bound.
+    /// Returns valid().
+    bool seek(const Word &lower_bound)
+    {
+        m_frames.clear();
+        m_word.clear();
+
+        // Follow lower_bound down the tree. The strings read along the way are
+        // proper prefixes of lower_bound, hence lower than it, and so are the
+        // children lower than its next character.
+        const node_t *node = &m_tree.root();
+        bool partial = false;
+        for(const T &input : lower_bound) {
+            const typename node_t::const_iterator it = node->lower_bound(input);
+            if(it == node->end() || input < it->first) {
+                m_frames.push_back(frame {node, it, false});
+                partial = true;
+                break;
+            }
+            m_frames.push_back(frame {node, std::next(it), false});
+            m_word.push_back(input);
+            node = &it->second;
+        }
+        if(!partial) {
+            push_frame(*node);
+        }
+        return settle();
+    }
+
+    /// Positions the cursor on the first string starting with prefix, the
+    /// following strings being limited to those starting with prefix.
+    /// Returns valid().
+    bool seek_prefix(const Word &prefix)
+    {
+        m_frames.clear();
+        m_word.assign(prefix.begin(), prefix.end());
+
+        const node_t *node = &m_tree.root();
+        for(const T &input : prefix) {
+            node = node->child_ptr(input);
+            if(!node) {
+                return m_valid = false;
+            }
+        }
+        push_frame(*node);
+        return settle();
+    }
+
+    /// Makes the cursor stop before the first string not lower than
+    /// upper_bound, from the current string on.
+    void set_upper_bound(const Word &upper_bound)
+    {
+        m_upper_bound.assign(upper_bound.begin(), upper_bound.end());
+        m_has_upper_bound = true;
+        m_valid = m_valid && below_upper_bound();
+    }
+
+    /// Removes the upper bound, if any.
+    void clear_upper_bound() { m_has_upper_bound = false; }
+
+    /// Moves the cursor to the next string. Returns valid().
+    bool next()
+    {
+        return m_valid ? settle() : false;
+    }
+
+    /// Returns whether the cursor is positioned on a string.
+    bool valid() const { return m_valid; }
+
+    /// Returns the current string (without end marker), valid until the
+    /// cursor moves.
+    const Word& word() const { return m_word; }
+
+private:
+    /// Node on the path to the current string.
+    struct frame {
+        const node_t *node;
+        typename node_t::const_iterator next; // next child to visit
+        bool end_pending;                     // whether the string of the node is yet to be visited
+    };
+
+    void push_frame(const node_t &node)
+    {
+        m_frames.push_back(
+            frame {&node, node.begin(), node.child_ptr(m_end_marker) != nullptr}
+        );
+    }
+
+    /// Moves to the next string in the tree, if any, within the upper bound.
+    bool settle()
+    {
+        m_valid = advance() && below_upper_bound();
+        return m_valid;
+    }
+
+    /// Moves to the next string in the tree. Returns false if there is none,
+    /// i.e. if the stack becomes empty.
+    bool advance()
+    {
+        while(!m_frames.empty()) {
+            frame &top = m_frames.back();
+            if(top.end_pending) {
+                // A string comes before its extensions.
+                top.end_pending = false;
+                return true;
+            }
+            if(top.next == top.node->end()) {
+                m_frames.pop_back();
+                if(m_frames.empty()) {
+                    break;
+                }
+                m_word.pop_back();
+                continue;
+            }
+            const typename node_t::const_iterator it = top.next++;
+            if(it->first == m_end_marker) {
+                continue;
+            }
+            m_word.push_back(it->first);
+            push_frame(it->second);
+        }
+        return false;
+    }
+
+    bool below_upper_bound() const
+    {
+        return !m_has_upper_bound
+            || std::lexicographical_compare(m_word.begin(), m_word.end(),
+                                            m_upper_bound.begin(), m_upper_bound.end());
+    }
+
+private:
+    const dfa_tree<T> &m_tree;
+    T m_end_marker;
+    std::vector<frame> m_frames;
+    Word m_word;
+    Word m_upper_bound;
+    bool m_has_upper_bound {false};
+    bool m_valid {false};
+};
+
+#endif // DFA_TREE_CURSOR_H
@@ -30,6 +30,8 @@
 #include "dfa_tree.hpp"
 
 #include <iostream>
+#include <stack>
+#include <utility>
 
 /// Utility class for the dfa_tree class.
 class dfa_tree_utils
@@ -63,6 +65,37 @@ public:
         }
     }
 
+    /// Returns the number of nodes in tree, root node excluded.
+    template<typename T>
+    static size_t number_of_nodes(const dfa_tree<T>& tree)
+    {
+        size_t count = 0;
+        std::stack<const typename dfa_tree<T>::node_t*> unvisited_nodes;
+        unvisited_nodes.push(&tree.root());
+        while(!unvisited_nodes.empty()) {
+            const auto *node = unvisited_nodes.top();
+            unvisited_nodes.pop();
+            for(auto it = node->begin(); it != node->end(); it++) {
+                count++;
+                unvisited_nodes.push(&it->second);
+            }
+        }
+        return count;
+    }
+
+    /// Returns an estimate of the memory used by tree in bytes. Each node is
+    /// stored in the std::map of its parent, whose nodes usually hold a color
+    /// and three pointers in addition to the stored key/value pair. Allocator
+    /// overhead is not taken into account.
+    template<typename T>
+    static size_t approximate_memory_usage(const dfa_tree<T>& tree)
+    {
+        typedef typename dfa_tree<T>::node_t node_t;
+        const size_t map_node_size = sizeof(std::pair<const T, node_t>)
+                                   + 4 * sizeof(void*);
+        return sizeof(tree) + number_of_nodes(tree) * map_node_size;
+    }
+
 private:
     template<typename T>
     static void print_sub_tree_bracketed(const typename dfa_tree<T>::node_t &node,
@@ -0,0 +1,241 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "exact_match_filter.h"
+
+#include <cstring>
+
+namespace {
+
+size_t popcount(std::uint64_t word)
+{
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    size_t count = 0;
+    for(; word; word &= word - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+} // namespace
+
+exact_match_filter::exact_match_filter(
+    const std::vector<std::string> &strings,
+    unsigned int bloom_bits_per_string
+)
+{
+    const size_t n = strings.size();
+    std::vector<std::uint64_t> hashes(n);
+    for(size_t i = 0; i < n; i++) {
+        hashes[i] = hash(strings[i].data(), strings[i].length());
+    }
+
+    // Bloom filter (none if no bits are allowed).
+    if(bloom_bits_per_string > 0 && n > 0) {
+        m_bloom_block_count = (n * bloom_bits_per_string + 511) / 512;
+        m_bloom_storage.assign(m_bloom_block_count * bloom_block_words + 7, 0);
+        for(const std::uint64_t h : hashes) {
+            bloom_add(h);
+        }
+    }
+
+    // Perfect hash function: each level keeps the strings landing alone on a
+    // bit and passes the others on to the next level.
+    std::vector<size_t> remaining(n);
+    for(size_t i = 0; i < n; i++) {
+        remaining[i] = i;
+    }
+    std::vector<size_t> next;
+    std::vector<std::uint64_t> seen;
+    std::vector<std::uint64_t> collided;
+    while(!remaining.empty() && m_levels.size() < levels_max) {
+        const size_t l = m_levels.size();
+        level lv;
+        lv.first_word = m_words.size();
+        lv.size = (2 * remaining.size() + 63) / 64 * 64;
+        seen.assign(lv.size / 64, 0);
+        collided.assign(lv.size / 64, 0);
+        for(const size_t i : remaining) {
+            const size_t pos = reduce(level_hash(hashes[i], l), lv.size);
+            const std::uint64_t bit = 1ULL << (pos % 64);
+            if(seen[pos / 64] & bit) {
+                collided[pos / 64] |= bit;
+            }
+            seen[pos / 64] |= bit;
+        }
+        next.clear();
+        for(const size_t i : remaining) {
+            const size_t pos = reduce(level_hash(hashes[i], l), lv.size);
+            if(collided[pos / 64] & (1ULL << (pos % 64))) {
+                next.push_back(i);
+            }
+        }
+        for(size_t w = 0; w < seen.size(); w++) {
+            m_words.push_back({seen[w] & ~collided[w], 0});
+        }
+        m_levels.push_back(lv);
+        remaining.swap(next);
+    }
+
+    std::vector<bool> placed(n, true);
+    for(const size_t i : remaining) {
+        placed[i] = false;
+        m_unplaced.insert(strings[i]);
+    }
+
+    std::uint64_t rank = 0;
+    for(rank_word &word : m_words) {
+        word.rank = rank;
+        rank += popcount(word.bits);
+    }
+
+    // Lay the strings out in slot order, so that confirming a hit reads
+    // memory next to that of the neighboring slots only.
+    std::vector<size_t> string_of_slot(rank);
+    for(size_t i = 0; i < n; i++) {
+        if(placed[i]) {
+            string_of_slot[slot_of(hashes[i])] = i;
+        }
+    }
+    m_slots.resize(rank);
+    for(size_t s = 0; s < m_slots.size(); s++) {
+        const size_t i = string_of_slot[s];
+        m_slots[s].offset = m_strings.size();
+        m_slots[s].length = static_cast<std::uint32_t>(strings[i].length());
+        m_slots[s].fingerprint = static_cast<std::uint32_t>(hashes[i]);
+        m_strings += strings[i];
+    }
+}
+
+bool exact_match_filter::contains(const char *str, size_t length) const
+{
+    const std::uint64_t h = hash(str, length);
+    if(!bloom_may_contain(h)) {
+        return false;
+    }
+
+    const size_t s = slot_of(h);
+    if(s == static_cast<size_t>(-1)) {
+        return !m_unplaced.empty()
+            && m_unplaced.count(std::string(str, length)) != 0;
+    }
+    const slot &sl = m_slots[s];
+    return sl.fingerprint == static_cast<std::uint32_t>(h)
+        && sl.length == length
+        && std::memcmp(m_strings.data() + sl.offset, str, length) == 0;
+}
+
+size_t exact_match_filter::memory_usage() const
+{
+    size_t usage = m_bloom_storage.capacity() * sizeof(std::uint64_t)
+                 + m_levels.capacity() * sizeof(level)
+                 + m_words.capacity() * sizeof(rank_word)
+                 + m_slots.capacity() * sizeof(slot)
+                 + m_strings.capacity();
+    for(const std::string &str : m_unplaced) {
+        usage += sizeof(str) + str.capacity();
+    }
+    return usage;
+}
+
+std::uint64_t exact_match_filter::hash(const char *str, size_t length)
+{
+    // Reads 8 bytes at a time, the length telling apart strings whose last
+    // chunks only differ by trailing null bytes.
+    std::uint64_t h = mix(length * 0x9E3779B97F4A7C15ULL);
+    size_t i = 0;
+    for(; i + 8 <= length; i += 8) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, str + i, 8);
+        h = mix(h ^ chunk);
+    }
+    std::uint64_t chunk = 0;
+    std::memcpy(&chunk, str + i, length - i);
+    return mix(h ^ chunk);
+}
+
+std::uint64_t exact_match_filter::mix(std::uint64_t h)
+{
+    // Finalizer of MurmurHash3.
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+const std::uint64_t* exact_match_filter::bloom_blocks() const
+{
+    const std::uint64_t *storage = m_bloom_storage.data();
+    const size_t misalignment = reinterpret_cast<std::uintptr_t>(storage) % 64;
+    return storage + (misalignment ? (64 - misalignment) / sizeof(std::uint64_t) : 0);
+}
+
+void exact_match_filter::bloom_add(std::uint64_t h)
+{
+    std::uint64_t *block = const_cast<std::uint64_t *>(bloom_blocks())
+                         + reduce(h, m_bloom_block_count) * bloom_block_words;
+    const std::uint64_t bits = mix(h ^ 0xD6E8FEB86659FD93ULL);
+    for(unsigned int i = 0; i < bloom_bits_per_block_string; i++) {
+        const size_t pos = (bits >> (9 * i)) & 511;
+        block[pos / 64] |= 1ULL << (pos % 64);
+    }
+}
+
+bool exact_match_filter::bloom_may_contain(std::uint64_t h) const
+{
+    if(m_bloom_block_count == 0) {
+        return true;
+    }
+    const std::uint64_t *block = bloom_blocks()
+                               + reduce(h, m_bloom_block_count) * bloom_block_words;
+    const std::uint64_t bits = mix(h ^ 0xD6E8FEB86659FD93ULL);
+    for(unsigned int i = 0; i < bloom_bits_per_block_string; i++) {
+        const size_t pos = (bits >> (9 * i)) & 511;
+        if(!(block[pos / 64] & (1ULL << (pos % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t exact_match_filter::slot_of(std::uint64_t h) const
+{
+    for(size_t l = 0; l < m_levels.size(); l++) {
+        const level &lv = m_levels[l];
+        const size_t pos = reduce(level_hash(h, l), lv.size);
+        const rank_word &word = m_words[lv.first_word + pos / 64];
+        const std::uint64_t bit = 1ULL << (pos % 64);
+        if(word.bits & bit) {
+            return static_cast<size_t>(word.rank + popcount(word.bits & (bit - 1)));
+        }
+    }
+    return static_cast<size_t>(-1);
+}
@@ -0,0 +1,143 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef EXACT_MATCH_FILTER_H
+#define EXACT_MATCH_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// A static set of strings answering membership queries in a few cache line
+/// accesses, meant to be used in front of the character tree of a
+/// dfa_string_dict for exact lookups. Two structures are built from the same
+/// 64-bit hash of each string:
+///     - A blocked Bloom filter: each string sets a few bits in a single block
+///       of 512 bits (one cache line), so that most strings which were not
+///       added are rejected after reading that block only.
+///     - A minimal perfect hash function mapping each string added to a
+///       distinct slot in [0, n) (BBHash): strings are hashed into a bit array
+///       twice as large as their number, those landing alone on a bit keep
+///       it, the others moving on to the next, smaller, bit array. The slot
+///       of a string is the rank of its bit among all bits set. Each slot
+///       holds a fingerprint of its string, which rejects the strings that
+///       went through the Bloom filter by mistake, and the location of the
+///       string itself, which confirms hits.
+///
+/// Answers are therefore exact. Strings added afterwards to the dictionary
+/// require building the filter again.
+class exact_match_filter
+{
+public:
+    /// Builds the filter from distinct strings, using about
+    /// bloom_bits_per_string bits per string for the Bloom filter.
+    explicit exact_match_filter(const std::vector<std::string> &strings,
+                                unsigned int bloom_bits_per_string = 10);
+
+    // The Bloom filter depends on the alignment of its storage.
+    exact_match_filter(const exact_match_filter &) = delete;
+    exact_match_filter& operator=(const exact_match_filter &) = delete;
+
+    /// Returns whether the given string is one of the strings given at
+    /// construction.
+    bool contains(const char *str, size_t length) const;
+
+    bool contains(const std::string &str) const
+    { return contains(str.data(), str.length()); }
+
+    /// Returns false if the Bloom filter alone shows that the given string is
+    /// not one of the strings given at construction.
+    bool may_contain(const char *str, size_t length) const
+    { return bloom_may_contain(hash(str, length)); }
+
+    /// Returns the number of strings given at construction.
+    size_t size() const { return m_slots.size() + m_unplaced.size(); }
+
+    /// Returns the memory used by this filter in bytes, strings included.
+    size_t memory_usage() const;
+
+private:
+    /// Bits of a level of the perfect hash function, 64 at a time, with the
+    /// number of bits set in all previous words (read in the same cache line).
+    struct rank_word {
+        std::uint64_t bits;
+        std::uint64_t rank;
+    };
+
+    struct level {
+        size_t first_word; // index of the first word of this level in m_words
+        size_t size;       // number of bits (multiple of 64)
+    };
+
+    /// Content of the slot of a string.
+    struct slot {
+        std::uint64_t offset;      // offset of the string in m_strings
+        std::uint32_t length;      // length of the string
+        std::uint32_t fingerprint; // low bits of the hash of the string
+    };
+
+    static const size_t bloom_block_words = 8; // 512 bits
+    static const unsigned int bloom_bits_per_block_string = 7;
+    static const size_t levels_max = 32;
+
+    static std::uint64_t hash(const char *str, size_t length);
+    static std::uint64_t mix(std::uint64_t h);
+
+    /// Maps h to [0, n) using its high 32 bits (n < 2^32).
+    static size_t reduce(std::uint64_t h, size_t n)
+    { return static_cast<size_t>(((h >> 32) * n) >> 32); }
+
+    /// Returns the hash of level l of the perfect hash function.
+    static std::uint64_t level_hash(std::uint64_t h, size_t l)
+    { return mix(h + (l + 1) * 0x9E3779B97F4A7C15ULL); }
+
+    const std::uint64_t* bloom_blocks() const;
+    void bloom_add(std::uint64_t h);
+    bool bloom_may_contain(std::uint64_t h) const;
+
+    /// Returns the slot of h, or size_t(-1) if no bit is set for h at any
+    /// level.
+    size_t slot_of(std::uint64_t h) const;
+
+private:
+    // Bloom filter, the first block starting at the first 64-byte aligned
+    // address of the storage.
+    std::vector<std::uint64_t> m_bloom_storage;
+    size_t m_bloom_block_count {0};
+
+    std::vector<level> m_levels;
+    std::vector<rank_word> m_words;
+    std::vector<slot> m_slots;
+    std::string m_strings; // strings concatenated in slot order
+
+    // Strings colliding at every level, i.e. those whose hashes collide with
+    // another string, which should hardly ever happen.
+    std::unordered_set<std::string> m_unplaced;
+};
+
+#endif // EXACT_MATCH_FILTER_H
@@ -0,0 +1,309 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "qgram_index.h"
+
+#include <algorithm>
+
+qgram_index::qgram_index(unsigned int q, char padding)
+    : m_q(std::min(std::max(q, 1u), 8u))
+    , m_padding(padding)
+{
+}
+
+void qgram_index::add_string(const std::string &str)
+{
+    const string_id id = static_cast<string_id>(m_strings.size());
+    m_strings.push_back(str);
+
+    if(m_strings_by_length.size() <= str.length()) {
+        m_strings_by_length.resize(str.length() + 1);
+    }
+    m_strings_by_length[str.length()].push_back(id);
+
+    // Identifiers are added in increasing order, so posting lists remain
+    // sorted and repeated q-grams yield adjacent duplicates.
+    std::vector<gram_t> grams;
+    collect_grams(str, grams);
+    for(const gram_t gram : grams) {
+        m_postings[gram].push_back(id);
+    }
+}
+
+void qgram_index::clear()
+{
+    m_strings.clear();
+    m_strings_by_length.clear();
+    m_postings.clear();
+}
+
+bool qgram_index::find_levenshtein_distance(
+    const std::string &str,
+    unsigned int edit_max,
+    std::string &matched,
+    unsigned int &cost,
+    const verification_budget *budget
+) const
+{
+    return find(str, edit_max, false, matched, cost, budget);
+}
+
+bool qgram_index::find_allow_substitution(
+    const std::string &str,
+    unsigned int subst_max,
+    std::string &matched,
+    unsigned int &cost,
+    const verification_budget *budget
+) const
+{
+    return find(str, subst_max, true, matched, cost, budget);
+}
+
+unsigned int qgram_index::bounded_levenshtein_distance(
+    const std::string &a,
+    const std::string &b,
+    unsigned int max
+)
+{
+    // Same recurrence as in dfa_string_dict::match_string_levenshtein_distance()
+    // but only cells such that |i - j| <= max are computed, since the others
+    // necessarily hold a value greater than max. Such cells are set to max + 1
+    // so that they never contribute to the result.
+
+    typedef unsigned int uint;
+
+    const uint a_len = a.length();
+    const uint b_len = b.length();
+    const uint out_of_bound = max + 1;
+    if((a_len > b_len ? a_len - b_len : b_len - a_len) > max) {
+        return out_of_bound;
+    }
+
+    thread_local std::vector<uint> prev_row;
+    thread_local std::vector<uint> curr_row;
+    prev_row.assign(b_len + 1, out_of_bound);
+    curr_row.assign(b_len + 1, out_of_bound);
+    for(uint j = 0; j <= b_len && j <= max; j++) {
+        prev_row[j] = j;
+    }
+
+    for(uint i = 1; i <= a_len; i++) {
+        const uint j_min = i > max ? i - max : 1;
+        const uint j_max = std::min(b_len, i + max);
+
+        curr_row[j_min - 1] = (j_min == 1 && i <= max) ? i : out_of_bound;
+        uint row_min = curr_row[j_min - 1];
+        for(uint j = j_min; j <= j_max; j++) {
+            const uint cell = std::min({
+                curr_row[j-1] + 1, // insertion cost
+                prev_row[j] + 1, // deletion cost
+                prev_row[j-1] + (a[i-1] == b[j-1] ? 0 : 1), // substitution cost
+            });
+            curr_row[j] = std::min(cell, out_of_bound);
+            row_min = std::min(row_min, curr_row[j]);
+        }
+        if(j_max < b_len) {
+            curr_row[j_max + 1] = out_of_bound;
+        }
+
+        if(row_min > max) {
+            return out_of_bound;
+        }
+        std::swap(prev_row, curr_row);
+    }
+
+    return prev_row[b_len];
+}
+
+void qgram_index::collect_grams(
+    const std::string &str,
+    std::vector<gram_t> &grams
+) const
+{
+    const std::string &padding = std::string(m_q - 1, m_padding);
+    const std::string &padded = padding + str + padding;
+
+    grams.clear();
+    for(size_t i = 0; i + m_q <= padded.length(); i++) {
+        gram_t gram = 0;
+        for(size_t j = i; j < i + m_q; j++) {
+            gram = (gram << 8) | static_cast<unsigned char>(padded[j]);
+        }
+        grams.push_back(gram);
+    }
+}
+
+bool qgram_index::find(
+    const std::string &str,
+    unsigned int cost_max,
+    bool substitution_only,
+    std::string &matched,
+    unsigned int &cost,
+    const verification_budget *budget
+) const
+{
+    typedef unsigned int uint;
+
+    // No edit distance exceeds the length of the longest of the two strings,
+    // so larger costs are clamped, which keeps cost_max + 1 from wrapping.
+    const size_t length_max = std::max(
+        str.length(),
+        m_strings_by_length.empty() ? 0 : m_strings_by_length.size() - 1
+    );
+    if(cost_max > length_max) {
+        cost_max = static_cast<uint>(length_max);
+    }
+
+    const long long s_len = str.length();
+    const long long len_min = substitution_only ? s_len : std::max(0LL, s_len - cost_max);
+    const long long len_max = std::min(
+        substitution_only ? s_len : s_len + cost_max,
+        static_cast<long long>(m_strings_by_length.size()) - 1
+    );
+
+    // Minimum number of q-grams a string of the given length must share with
+    // str. A non-positive value means that the count filter cannot discard any
+    // string of that length.
+    auto count_threshold = [&](long long len) {
+        return std::max(s_len, len) + m_q - 1 - static_cast<long long>(cost_max) * m_q;
+    };
+
+    // A bounded search also keeps the closest candidate beyond cost_max, to be
+    // offered if it stops early, so candidates are then verified up to the
+    // cost of the closest one so far instead (length_max + 1 meaning none).
+    string_id best_id {0};
+    uint best_cost = cost_max + 1;
+    string_id closest_id {0};
+    uint closest_cost = static_cast<uint>(length_max) + 1;
+    bool stopped {false};
+    auto verify = [&](string_id id) {
+        if(budget && !budget->spend()) {
+            stopped = true;
+            return;
+        }
+        const std::string &candidate = m_strings[id];
+        uint candidate_cost_max = std::min(best_cost, cost_max);
+        if(budget && closest_cost > 0) {
+            candidate_cost_max = std::max(candidate_cost_max, closest_cost - 1);
+        }
+        uint candidate_cost = 0;
+        if(substitution_only) {
+            for(size_t i = 0; i < candidate.length() && candidate_cost <= candidate_cost_max; i++) {
+                candidate_cost += candidate[i] == str[i] ? 0 : 1;
+            }
+        }
+        else {
+            candidate_cost = bounded_levenshtein_distance(str, candidate, candidate_cost_max);
+        }
+        if(candidate_cost > candidate_cost_max) {
+            return;
+        }
+        if(candidate_cost < closest_cost) {
+            closest_id = id;
+            closest_cost = candidate_cost;
+        }
+        if(candidate_cost > cost_max) {
+            return;
+        }
+        if(candidate_cost < best_cost || id < best_id) {
+            best_id = id;
+            best_cost = candidate_cost;
+        }
+    };
+
+    // Count the q-grams shared by str and each indexed string, using a
+    // per-thread counter array so that concurrent queries are possible.
+    thread_local std::vector<uint> shared_counts;
+    thread_local std::vector<string_id> touched_ids;
+    if(shared_counts.size() < m_strings.size()) {
+        shared_counts.resize(m_strings.size(), 0);
+    }
+    touched_ids.clear();
+
+    std::vector<gram_t> grams;
+    collect_grams(str, grams);
+    std::sort(grams.begin(), grams.end());
+    for(size_t i = 0; i < grams.size(); ) {
+        size_t i_end = i;
+        while(i_end < grams.size() && grams[i_end] == grams[i]) {
+            i_end++;
+        }
+        const uint gram_count = i_end - i; // occurrences of the q-gram in str
+
+        const auto postings_it = m_postings.find(grams[i]);
+        if(postings_it != m_postings.end()) {
+            const std::vector<string_id> &ids = postings_it->second;
+            for(size_t j = 0; j < ids.size(); ) {
+                size_t j_end = j;
+                while(j_end < ids.size() && ids[j_end] == ids[j]) {
+                    j_end++;
+                }
+                if(shared_counts[ids[j]] == 0) {
+                    touched_ids.push_back(ids[j]);
+                }
+                shared_counts[ids[j]] += std::min<uint>(j_end - j, gram_count);
+                j = j_end;
+            }
+        }
+        i = i_end;
+    }
+
+    // Verify the strings passing the length and count filters. Counters are
+    // reset even once the search is stopped.
+    for(const string_id id : touched_ids) {
+        const long long len = m_strings[id].length();
+        if(len_min <= len && len <= len_max && !stopped) {
+            const long long threshold = count_threshold(len);
+            if(threshold > 0 && shared_counts[id] >= threshold && best_cost > 0) {
+                verify(id);
+            }
+        }
+        shared_counts[id] = 0;
+    }
+    for(long long len = len_min; len <= len_max && best_cost > 0 && !stopped; len++) {
+        if(count_threshold(len) <= 0) {
+            for(const string_id id : m_strings_by_length[len]) {
+                verify(id);
+                if(stopped) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if(stopped) {
+        if(closest_cost <= length_max) {
+            budget->offer(m_strings[closest_id], closest_cost);
+        }
+        return false;
+    }
+    if(best_cost > cost_max) {
+        return false;
+    }
+    matched = m_strings[best_id];
+    cost = best_cost;
+    return true;
+}
@@ -0,0 +1,132 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef QGRAM_INDEX_H
+#define QGRAM_INDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// An inverted index from q-grams (substrings of length q) to the strings they
+/// occur in. It is meant to be used next to dfa_string_dict when a large number
+/// of edits is allowed, because the character tree then has to visit most of
+/// its nodes while this index only verifies a short list of candidates.
+///
+/// Candidates are selected using the count filter: if Lev(s, t) <= k, then the
+/// padded strings s and t share at least max(|s|, |t|) + q - 1 - k*q q-grams,
+/// since each edit operation destroys at most q of them. Candidates are then
+/// verified using a Levenshtein distance computation restricted to a band of
+/// 2k+1 diagonals.
+class qgram_index
+{
+public:
+    /// Creates an index for q-grams of length q (between 1 and 8). The padding
+    /// character is used to extend strings on both sides before extracting
+    /// q-grams and must not appear in indexed strings.
+    explicit qgram_index(unsigned int q, char padding);
+
+    unsigned int q() const { return m_q; }
+
+    /// Returns the number of strings in this index.
+    size_t size() const { return m_strings.size(); }
+
+    /// Adds a string to this index. Duplicates are not detected here, so the
+    /// caller should avoid adding the same string twice.
+    void add_string(const std::string &str);
+
+    /// Clears this index.
+    void clear();
+
+    /// Bounds the work of a search: spend is called before each candidate is
+    /// verified and stops the search as soon as it returns false. The search
+    /// then fails, and offer is given the closest candidate verified so far,
+    /// if any, along with its cost, which may exceed the allowed one.
+    struct verification_budget {
+        std::function<bool ()> spend;
+        std::function<void (const std::string &, unsigned int)> offer;
+    };
+
+    /// Searches for the indexed string closest to str in terms of Levenshtein
+    /// distance, provided that distance does not exceed edit_max. On success,
+    /// matched and cost are set accordingly; ties are broken in favor of the
+    /// string that was added first. The search is bounded by budget, if given.
+    bool find_levenshtein_distance(
+        const std::string &str,
+        unsigned int edit_max,
+        std::string &matched,
+        unsigned int &cost,
+        const verification_budget *budget = nullptr
+    ) const;
+
+    /// Same as find_levenshtein_distance() but only substitutions are allowed,
+    /// so only strings of the same length as str are considered.
+    bool find_allow_substitution(
+        const std::string &str,
+        unsigned int subst_max,
+        std::string &matched,
+        unsigned int &cost,
+        const verification_budget *budget = nullptr
+    ) const;
+
+    /// Returns the Levenshtein distance between a and b if it does not exceed
+    /// max, or max + 1 otherwise.
+    static unsigned int bounded_levenshtein_distance(
+        const std::string &a,
+        const std::string &b,
+        unsigned int max
+    );
+
+private:
+    typedef std::uint64_t gram_t;    // q-gram packed into an integer
+    typedef std::uint32_t string_id; // index of a string in m_strings
+
+    void collect_grams(const std::string &str, std::vector<gram_t> &grams) const;
+
+    bool find(
+        const std::string &str,
+        unsigned int cost_max,
+        bool substitution_only,
+        std::string &matched,
+        unsigned int &cost,
+        const verification_budget *budget
+    ) const;
+
+private:
+    unsigned int m_q;
+    char m_padding;
+    std::vector<std::string> m_strings;
+    std::vector<std::vector<string_id>> m_strings_by_length;
+
+    // For each q-gram, the identifiers of the strings containing it, in
+    // increasing order. An identifier is repeated as many times as the q-gram
+    // occurs in the corresponding string.
+    std::unordered_map<gram_t, std::vector<string_id>> m_postings;
+};
+
+#endif // QGRAM_INDEX_H
@@ -42,8 +42,29 @@ public:
         return m_dict.add_strings_from_file(filename);
     }
 
+    bool add_words_from_csv(const std::string &filename,
+                            const dfa_string_dict::csv_columns &columns)
+    {
+        return m_dict.add_strings_from_csv(filename, columns);
+    }
+
     void clear() { m_dict.clear(); }
 
+    void enable_qgram_index(unsigned int q = 2,
+                            unsigned int crossover_cost_max = 3)
+    { m_dict.enable_qgram_index(q, crossover_cost_max); }
+
+    void disable_qgram_index() { m_dict.disable_qgram_index(); }
+
+    void enable_bidirectional_search() { m_dict.enable_bidirectional_search(); }
+
+    void disable_bidirectional_search() { m_dict.disable_bidirectional_search(); }
+
+    void enable_exact_filter(unsigned int bloom_bits_per_string = 10)
+    { m_dict.enable_exact_filter(bloom_bits_per_string); }
+
+    void disable_exact_filter() { m_dict.disable_exact_filter(); }
+
     dfa_string_dict::match_result match_word_exactly(
         const std::string &word
     ) const
@@ -67,11 +88,36 @@ public:
         return m_dict.match_string_levenshtein_distance(word, edit_max);
     }
 
+    dfa_string_dict::match_result match_word_allow_substitution(
+        const std::string &word,
+        unsigned int subst_max,
+        const dfa_string_dict::search_limits &limits
+    ) const
+    {
+        return m_dict.match_string_allow_substitution(word, subst_max, limits);
+    }
+
+    dfa_string_dict::match_result match_word_levenshtein_distance(
+        const std::string &word,
+        unsigned int edit_max,
+        const dfa_string_dict::search_limits &limits
+    ) const
+    {
+        return m_dict.match_string_levenshtein_distance(word, edit_max, limits);
+    }
+
     void print_words(std::ostream &stream) const
     { m_dict.print_strings(stream); }
 
     void print_tree(std::ostream &stream) const { m_dict.print_tree(stream); }
 
+    /// Returns a cursor enumerating the words of this dictionary in
+    /// lexicographic order (see dfa_string_dict::cursor()).
+    dfa_string_dict::string_cursor cursor() const { return m_dict.cursor(); }
+
+    /// Returns the underlying dictionary of strings.
+    const dfa_string_dict& string_dict() const { return m_dict; }
+
     static char end_of_word_marker()
     { return dfa_string_dict::tree_end_of_string_marker; }
 
@@ -28,8 +28,17 @@
 
 #include "path.hpp"
 
-int main()
+int main(int argc, char *argv[])
 {
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    if(!args.empty()) {
+        const int status = args[0] == "--spellcheck" ? spellcheck(args) : 2;
+        if(status == 2) {
+            print_usage(argv[0]);
+        }
+        return status == 0 ? 0 : 1;
+    }
+
     word_dict dict;
 
     std::cout << title_str("Add sample words") << std::endl;
@@ -48,6 +57,11 @@ int main()
     match_sample_words(dict);
     std::cout << std::endl;
 
+    std::cout << title_str("Find sample words inside text") << std::endl;
+    find_words_in_text(dict, "abbaaaaba");
+    find_phrases_in_text();
+    std::cout << std::endl;
+
     std::cout << title_str("Add & Match words from a large file") << std::endl;
     dict.clear();
     add_and_match_words_from_resource_file(dict, path::parent(__FILE__));
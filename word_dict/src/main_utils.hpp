@@ -29,9 +29,21 @@
 
 #include "word_dict.hpp"
 
+#include "dfa_aho_corasick.hpp"
+#include "dfa_louds_dict.h"
+#include "dfa_query_session.h"
+#include "dfa_radix_tree.h"
+#include "dfa_tree_utils.hpp"
+#include "spellcheck_pipeline.h"
 #include "timer.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 
 const std::string &title_prefix = "--- ";
 const std::string &title_suffix = " ---";
@@ -105,6 +117,99 @@ void match_words(
     }
 }
 
+void compare_bidirectional_search(
+    word_dict &dict,
+    const std::vector<std::string> &words,
+    unsigned int cost_max
+)
+{
+    typedef dfa_string_dict::match_result (word_dict::*match_fn)(
+        const std::string &, unsigned int) const;
+
+    // Returns the time in milliseconds taken to match all words with each cost.
+    auto time_matches = [&](match_fn match) {
+        std::vector<double> times;
+        timer tm;
+        for(unsigned int i = 0; i <= cost_max; i++) {
+            tm.reset();
+            for(const std::string &word : words) {
+                (dict.*match)(word, i);
+            }
+            times.push_back(tm.elapsed_time());
+        }
+        return times;
+    };
+
+    dict.disable_bidirectional_search();
+    const auto &subst_times = time_matches(&word_dict::match_word_allow_substitution);
+    const auto &leven_times = time_matches(&word_dict::match_word_levenshtein_distance);
+    dict.enable_bidirectional_search();
+    const auto &subst_bidir_times = time_matches(&word_dict::match_word_allow_substitution);
+    const auto &leven_bidir_times = time_matches(&word_dict::match_word_levenshtein_distance);
+
+    const dfa_string_dict &string_dict = dict.string_dict();
+    std::cout << msg_prefix1
+              << "character tree: "
+              << dfa_tree_utils::number_of_nodes(string_dict.tree()) << " nodes, ~"
+              << dfa_tree_utils::approximate_memory_usage(string_dict.tree()) / 1024
+              << " KiB; reverse character tree: "
+              << dfa_tree_utils::number_of_nodes(*string_dict.reverse_tree()) << " nodes, ~"
+              << dfa_tree_utils::approximate_memory_usage(*string_dict.reverse_tree()) / 1024
+              << " KiB"
+              << std::endl;
+    for(unsigned int i = 0; i <= cost_max; i++) {
+        std::cout << (i == 0 ? msg_prefix1 : msg_prefix2)
+                  << "cost " << i << ": "
+                  << "subst " << subst_times[i] << " ms -> "
+                  << subst_bidir_times[i] << " ms, "
+                  << "leven " << leven_times[i] << " ms -> "
+                  << leven_bidir_times[i] << " ms"
+                  << std::endl;
+    }
+
+    dict.disable_bidirectional_search();
+}
+
+void match_words_within_limits(
+    const word_dict &dict,
+    const std::vector<std::string> &words,
+    unsigned int cost,
+    std::chrono::milliseconds time_max,
+    std::uint64_t node_expansion_max
+)
+{
+    // Each query gets its own deadline.
+    auto limits = [&]() {
+        dfa_string_dict::search_limits limits =
+            dfa_string_dict::search_limits::within(time_max);
+        limits.node_expansion_max = node_expansion_max;
+        return limits;
+    };
+
+    timer tm;
+    for(const std::string &word : words) {
+        tm.reset();
+        const dfa_string_dict::match_result &subst_match =
+            dict.match_word_allow_substitution(word, cost, limits());
+        std::cout << msg_prefix1
+                  << subst_match.full_descr()
+                  << (subst_match.complete ? "" : " [incomplete]")
+                  << " "
+                  << tm.elapsed_time_str()
+                  << std::endl;
+
+        tm.reset();
+        const dfa_string_dict::match_result &leven_match =
+            dict.match_word_levenshtein_distance(word, cost, limits());
+        std::cout << msg_prefix2
+                  << leven_match.full_descr()
+                  << (leven_match.complete ? "" : " [incomplete]")
+                  << " "
+                  << tm.elapsed_time_str()
+                  << std::endl;
+    }
+}
+
 void add_sample_words(word_dict &dict)
 {
     add_words(dict, {
@@ -130,6 +235,349 @@ void match_sample_words(const word_dict &dict)
     }, 4);
 }
 
+void find_words_in_text(const word_dict &dict, const std::string &text)
+{
+    const dfa_aho_corasick<char> automaton(dict.string_dict().tree(),
+                                           word_dict::end_of_word_marker());
+    std::cout << msg_prefix1 << "finding words in \"" << text << "\"" << std::endl;
+    automaton.scan(text.data(), text.size(), [&](size_t offset, size_t length) {
+        std::cout << msg_prefix2 << "offset " << offset << ": \""
+                  << text.substr(offset, length) << "\"" << std::endl;
+    });
+}
+
+void find_phrases_in_text()
+{
+    // Phrases are sequences of token ids, read from a tree of token ids.
+    const std::vector<std::string> &vocabulary {"new", "york", "city", "times", "square"};
+    const std::uint32_t end_marker = std::numeric_limits<std::uint32_t>::max();
+    const std::vector<std::vector<std::uint32_t>> &phrases {
+        {0, 1},    // new york
+        {0, 1, 2}, // new york city
+        {1, 3},    // york times
+        {3, 4},    // times square
+    };
+    dfa_tree<std::uint32_t> tree;
+    for(const std::vector<std::uint32_t> &phrase : phrases) {
+        dfa_tree<std::uint32_t>::node_t *node = &tree.root();
+        for(const std::uint32_t token : phrase) {
+            node = &node->set_child(token);
+        }
+        node->set_child(end_marker);
+    }
+
+    const std::vector<std::uint32_t> &text {0, 1, 3, 4, 0, 1, 2};
+    std::string text_str;
+    for(const std::uint32_t token : text) {
+        text_str += (text_str.empty() ? "" : " ") + vocabulary[token];
+    }
+    std::cout << msg_prefix1 << "finding phrases in \"" << text_str << "\"" << std::endl;
+    const dfa_aho_corasick<std::uint32_t> automaton(tree, end_marker);
+    automaton.scan(text.data(), text.size(), [&](size_t offset, size_t length) {
+        std::string phrase;
+        for(size_t i = offset; i < offset + length; i++) {
+            phrase += (phrase.empty() ? "" : " ") + vocabulary[text[i]];
+        }
+        std::cout << msg_prefix2 << "token " << offset << ": \"" << phrase << "\"" << std::endl;
+    });
+}
+
+void compare_text_scan(const word_dict &dict, const std::string &text)
+{
+    timer tm;
+    const dfa_aho_corasick<char> automaton(dict.string_dict().tree(),
+                                           word_dict::end_of_word_marker());
+    const std::string &build_time = tm.elapsed_time_str();
+
+    tm.reset();
+    size_t scan_count = 0;
+    automaton.scan(text.data(), text.size(), [&](size_t, size_t) { scan_count++; });
+    const std::string &scan_time = tm.elapsed_time_str();
+
+    tm.reset();
+    size_t lookup_count = 0;
+    for(size_t offset = 0; offset < text.size(); offset++) {
+        for(size_t length = 1; offset + length <= text.size(); length++) {
+            lookup_count += dict.string_dict().contains_string(text.substr(offset, length));
+        }
+    }
+    const std::string &lookup_time = tm.elapsed_time_str();
+
+    std::cout << msg_prefix1
+              << "automaton: " << automaton.number_of_nodes() << " nodes, ~"
+              << automaton.approximate_memory_usage() / 1024 << " KiB, built "
+              << build_time << std::endl
+              << msg_prefix2 << "text of " << text.size() << " characters: "
+              << scan_count << " words found by scanning " << scan_time << ", "
+              << lookup_count << " by looking up every substring " << lookup_time
+              << std::endl;
+}
+
+/// Returns the time in milliseconds taken to run f on every string.
+double time_strings(const std::vector<std::string> &strs,
+                    const std::function<void (const std::string &)> &f)
+{
+    timer tm;
+    for(const std::string &str : strs) {
+        f(str);
+    }
+    return tm.elapsed_time();
+}
+
+/// Returns one in every step strings of dict.
+std::vector<std::string> sample_strings(const dfa_string_dict &dict, size_t step)
+{
+    std::vector<std::string> strs;
+    size_t index = 0;
+    dict.gather_strings([&](const std::string &str) {
+        if(index++ % step == 0) {
+            strs.push_back(str.substr(0, str.length() - 1)); // remove the end of word marker
+        }
+    });
+    return strs;
+}
+
+void compare_radix_tree(
+    const word_dict &dict,
+    const std::vector<std::string> &words,
+    unsigned int cost
+)
+{
+    const dfa_string_dict &string_dict = dict.string_dict();
+    timer tm;
+    const dfa_radix_tree radix_tree(string_dict.tree(), word_dict::end_of_word_marker());
+    const std::string &build_time = tm.elapsed_time_str();
+
+    const std::vector<std::string> &lookups = sample_strings(string_dict, 16);
+    std::string matched;
+    unsigned int matched_cost;
+    const double tree_exact_time = time_strings(lookups, [&](const std::string &str) {
+        string_dict.contains_string(str);
+    });
+    const double radix_exact_time = time_strings(lookups, [&](const std::string &str) {
+        radix_tree.contains_string(str);
+    });
+    const double tree_subst_time = time_strings(words, [&](const std::string &str) {
+        string_dict.match_string_allow_substitution(str, cost);
+    });
+    const double radix_subst_time = time_strings(words, [&](const std::string &str) {
+        radix_tree.match_allow_substitution(str, cost, matched, matched_cost);
+    });
+    const double tree_leven_time = time_strings(words, [&](const std::string &str) {
+        string_dict.match_string_levenshtein_distance(str, cost);
+    });
+    const double radix_leven_time = time_strings(words, [&](const std::string &str) {
+        radix_tree.match_levenshtein_distance(str, cost, matched, matched_cost);
+    });
+
+    std::cout << msg_prefix1
+              << "character tree: "
+              << dfa_tree_utils::number_of_nodes(string_dict.tree()) << " nodes, ~"
+              << dfa_tree_utils::approximate_memory_usage(string_dict.tree()) / 1024
+              << " KiB; radix tree: "
+              << radix_tree.number_of_nodes() << " nodes, ~"
+              << radix_tree.approximate_memory_usage() / 1024 << " KiB, built "
+              << build_time << std::endl
+              << msg_prefix2 << lookups.size() << " exact lookups: "
+              << tree_exact_time << " ms -> " << radix_exact_time << " ms" << std::endl
+              << msg_prefix2 << "cost " << cost << ": "
+              << "subst " << tree_subst_time << " ms -> " << radix_subst_time << " ms, "
+              << "leven " << tree_leven_time << " ms -> " << radix_leven_time << " ms"
+              << std::endl;
+}
+
+void compare_louds_dict(
+    const word_dict &dict,
+    const std::vector<std::string> &words,
+    unsigned int cost
+)
+{
+    const dfa_string_dict &string_dict = dict.string_dict();
+    timer tm;
+    const dfa_louds_dict built_dict(string_dict);
+    const std::string &build_time = tm.elapsed_time_str();
+
+    // Queries run on a copy loaded from the serialized encoding.
+    std::stringstream stream;
+    built_dict.save(stream);
+    const size_t serialized_size = stream.str().size();
+    dfa_louds_dict louds_dict;
+    if(!louds_dict.load(stream)) {
+        std::cout << msg_prefix1 << "unable to load the encoded dictionary" << std::endl;
+        return;
+    }
+
+    const std::vector<std::string> &lookups = sample_strings(string_dict, 16);
+    std::string matched;
+    unsigned int matched_cost;
+    const double tree_exact_time = time_strings(lookups, [&](const std::string &str) {
+        string_dict.contains_string(str);
+    });
+    const double louds_exact_time = time_strings(lookups, [&](const std::string &str) {
+        louds_dict.contains_string(str);
+    });
+    const double tree_subst_time = time_strings(words, [&](const std::string &str) {
+        string_dict.match_string_allow_substitution(str, cost);
+    });
+    const double louds_subst_time = time_strings(words, [&](const std::string &str) {
+        louds_dict.match_allow_substitution(str, cost, matched, matched_cost);
+    });
+    const double tree_leven_time = time_strings(words, [&](const std::string &str) {
+        string_dict.match_string_levenshtein_distance(str, cost);
+    });
+    const double louds_leven_time = time_strings(words, [&](const std::string &str) {
+        louds_dict.match_levenshtein_distance(str, cost, matched, matched_cost);
+    });
+
+    std::cout << msg_prefix1
+              << "character tree: ~"
+              << dfa_tree_utils::approximate_memory_usage(string_dict.tree()) / 1024
+              << " KiB; LOUDS encoding: " << louds_dict.number_of_nodes() << " nodes, "
+              << louds_dict.memory_usage() / 1024 << " KiB ("
+              << 8.0 * louds_dict.memory_usage() / louds_dict.number_of_nodes()
+              << " bits per node), " << serialized_size / 1024 << " KiB serialized, built "
+              << build_time << std::endl
+              << msg_prefix2 << lookups.size() << " exact lookups: "
+              << tree_exact_time << " ms -> " << louds_exact_time << " ms" << std::endl
+              << msg_prefix2 << "cost " << cost << ": "
+              << "subst " << tree_subst_time << " ms -> " << louds_subst_time << " ms, "
+              << "leven " << tree_leven_time << " ms -> " << louds_leven_time << " ms"
+              << std::endl;
+}
+
+void compare_exact_filter(word_dict &dict)
+{
+    const dfa_string_dict &string_dict = dict.string_dict();
+    const std::vector<std::string> &hits = sample_strings(string_dict, 16);
+    std::vector<std::string> misses;
+    for(const std::string &str : hits) {
+        misses.push_back(str + "#"); // not a word in the resource file
+    }
+
+    // Returns the times in milliseconds taken to look hits and misses up.
+    auto time_lookups = [&]() {
+        return std::vector<double> {
+            time_strings(hits, [&](const std::string &str) {
+                string_dict.contains_string(str);
+            }),
+            time_strings(misses, [&](const std::string &str) {
+                string_dict.contains_string(str);
+            }),
+            time_strings(hits, [&](const std::string &str) {
+                dict.match_word_exactly(str);
+            }),
+        };
+    };
+
+    dict.disable_exact_filter();
+    const std::vector<double> &tree_times = time_lookups();
+    timer tm;
+    dict.enable_exact_filter();
+    const std::string &build_time = tm.elapsed_time_str();
+    const std::vector<double> &filter_times = time_lookups();
+    const size_t filter_memory_usage = string_dict.exact_filter()->memory_usage();
+    const dfa_string_dict::match_result &match = dict.match_word_exactly(misses.front());
+    dict.disable_exact_filter();
+
+    std::cout << msg_prefix1
+              << "filter: ~" << filter_memory_usage / 1024 << " KiB, built "
+              << build_time << std::endl
+              << msg_prefix2 << hits.size() << " lookups of words: "
+              << tree_times[0] << " ms -> " << filter_times[0] << " ms" << std::endl
+              << msg_prefix2 << misses.size() << " lookups of non-words: "
+              << tree_times[1] << " ms -> " << filter_times[1] << " ms" << std::endl
+              << msg_prefix2 << hits.size() << " exact matches of words: "
+              << tree_times[2] << " ms -> " << filter_times[2] << " ms" << std::endl
+              << msg_prefix2 << match.full_descr() << std::endl;
+}
+
+void compare_query_session(
+    const word_dict &dict,
+    const std::vector<std::string> &typed_words,
+    unsigned int cost
+)
+{
+    const dfa_string_dict &string_dict = dict.string_dict();
+    for(const std::string &word : typed_words) {
+        // Match every prefix of the word from scratch, then using a session.
+        timer tm;
+        for(size_t length = 1; length <= word.length(); length++) {
+            string_dict.match_string_levenshtein_distance(word.substr(0, length), cost);
+        }
+        const std::string &scratch_time = tm.elapsed_time_str();
+
+        tm.reset();
+        dfa_query_session session(string_dict, cost);
+        size_t frontier_size_max = session.frontier_size();
+        for(const char c : word) {
+            session.push_char(c);
+            session.match();
+            frontier_size_max = std::max(frontier_size_max, session.frontier_size());
+        }
+        const std::string &session_time = tm.elapsed_time_str();
+
+        std::cout << msg_prefix1
+                  << "typing \"" << word << "\": " << scratch_time << " -> "
+                  << session_time << ", frontier of at most "
+                  << frontier_size_max << " nodes" << std::endl
+                  << msg_prefix2 << session.match().full_descr() << std::endl;
+
+        session.pop_char();
+        session.pop_char();
+        std::cout << msg_prefix2 << "after 2 backspaces: "
+                  << session.match().full_descr() << std::endl;
+    }
+}
+
+void scan_words_with_cursor(const word_dict &dict)
+{
+    const dfa_string_dict &string_dict = dict.string_dict();
+
+    timer tm;
+    size_t gathered_count = 0;
+    size_t gathered_length = 0;
+    string_dict.gather_strings([&](const std::string &str) {
+        gathered_count++;
+        gathered_length += str.length() - 1; // remove the end of word marker
+    });
+    const std::string &gather_time = tm.elapsed_time_str();
+
+    tm.reset();
+    dfa_string_dict::string_cursor cursor = dict.cursor();
+    size_t scanned_count = 0;
+    size_t scanned_length = 0;
+    for(bool ok = cursor.first(); ok; ok = cursor.next()) {
+        scanned_count++;
+        scanned_length += cursor.word().length();
+    }
+    const std::string &scan_time = tm.elapsed_time_str();
+
+    std::cout << msg_prefix1
+              << "gather_strings(): " << gathered_count << " words ("
+              << gathered_length << " characters) " << gather_time << std::endl
+              << msg_prefix2
+              << "cursor: " << scanned_count << " words ("
+              << scanned_length << " characters) " << scan_time << std::endl;
+
+    // Returns the words of the current range, up to a few of them.
+    auto range_words = [&](bool ok) {
+        std::string words;
+        size_t count = 0;
+        for(; ok; ok = cursor.next()) {
+            if(count++ < 5) {
+                words += " " + cursor.word();
+            }
+        }
+        return std::to_string(count) + " words:" + words + (count > 5 ? " ..." : "");
+    };
+
+    std::cout << msg_prefix2 << "words with prefix \"abs\": "
+              << range_words(cursor.seek_prefix("abs")) << std::endl;
+    cursor.set_upper_bound("zoom");
+    std::cout << msg_prefix2 << "words from \"zoo\" to \"zoom\" (excluded): "
+              << range_words(cursor.seek("zoo")) << std::endl;
+}
+
 void add_and_match_words_from_resource_file(
     word_dict &dict,
     const std::string &dir_path
@@ -139,13 +587,179 @@ void add_and_match_words_from_resource_file(
         return;
     }
 
-    match_words(dict, {
+    const std::vector<std::string> &words {
         "s-sq-i--rp-ne",   // knowing that sesquiterpene     is one of the words in the dictionary
         "woolen*sto?k-ed", // knowing that woolen-stockinged is one of the words in the dictionary
         "o.bathering",     // knowing that woolgathering     is one of the words in the dictionary
         "0123456789",
         "abcdefghij",
-    }, 9);
+    };
+    match_words(dict, words, 9);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "matching again using a q-gram index for large costs"
+              << std::endl;
+    dict.enable_qgram_index();
+    match_words(dict, words, 9);
+    dict.disable_qgram_index();
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "matching again within 10 ms or 100000 node expansions"
+              << std::endl;
+    match_words_within_limits(dict, words, 9, std::chrono::milliseconds(10), 100000);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "comparing match times with and without bidirectional search"
+              << std::endl;
+    compare_bidirectional_search(dict, words, 4);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "finding words inside text in a single pass"
+              << std::endl;
+    std::string text;
+    for(int i = 0; i < 8; i++) {
+        text += "the quick brown fox jumps over the lazy dog while woolgathering ";
+    }
+    compare_text_scan(dict, text);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "comparing the character tree with a path-compressed copy"
+              << std::endl;
+    compare_radix_tree(dict, words, 2);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "comparing the character tree with its succinct LOUDS encoding"
+              << std::endl;
+    compare_louds_dict(dict, words, 2);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "comparing exact lookups with and without a front filter"
+              << std::endl;
+    compare_exact_filter(dict);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "matching words as they are typed, with and without a query session"
+              << std::endl;
+    compare_query_session(dict, {"woolgatherimg", "sesquitepene", "typeahaed"}, 2);
+
+    std::cout << std::endl;
+    std::cout << msg_prefix2
+              << "enumerating words in lexicographic order"
+              << std::endl;
+    scan_words_with_cursor(dict);
+}
+
+void print_usage(const std::string &program)
+{
+    std::cerr << "usage: " << program << std::endl
+              << "       " << program << " --spellcheck <dictionary file>"
+                 " [--edit-max <cost>] [--threads <count>]"
+                 " [--csv <word column> [--weight <column> <min weight>]]"
+                 " [<input file> [<output file>]]" << std::endl
+              << std::endl
+              << "Without arguments, runs the word-matching algorithms on sample"
+                 " data." << std::endl
+              << "With --spellcheck, writes the misspelled words of the input"
+                 " (standard input by default) to the output (standard output by"
+                 " default), one per line: <offset>\t<word>\t<correction>."
+              << " With --csv, the dictionary file is a CSV file with a header"
+                 " line, words being read from the given column (0 for the first"
+                 " one) of records whose weight, if any, is at least the minimum"
+                 " weight." << std::endl;
+}
+
+/// Runs the spell checker as described by print_usage(). Returns 0 on
+/// success, 1 on failure and 2 if the arguments are invalid.
+int spellcheck(const std::vector<std::string> &args)
+{
+    // args[0] is --spellcheck and args[1] the dictionary file
+    if(args.size() < 2) {
+        return 2;
+    }
+
+    spellcheck_pipeline::options opts;
+    bool csv = false;
+    dfa_string_dict::csv_columns csv_columns;
+    csv_columns.header = true;
+    std::vector<std::string> files;
+    try {
+        for(size_t i = 2; i < args.size(); i++) {
+            if(args[i] == "--edit-max" && i + 1 < args.size()) {
+                opts.edit_max = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--threads" && i + 1 < args.size()) {
+                opts.matcher_threads = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--csv" && i + 1 < args.size()) {
+                csv = true;
+                csv_columns.string_column = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--weight" && i + 2 < args.size()) {
+                csv_columns.weight_column = std::stoi(args[++i]);
+                csv_columns.min_weight = std::stod(args[++i]);
+                if(csv_columns.weight_column < 0) {
+                    return 2; // -1 would silently mean no weight column
+                }
+            }
+            else {
+                files.push_back(args[i]);
+            }
+        }
+    }
+    catch(const std::logic_error &) { // std::invalid_argument or std::out_of_range
+        return 2;
+    }
+    if(files.size() > 2 || (csv_columns.weight_column >= 0 && !csv)) {
+        return 2; // too many files, or --weight without --csv
+    }
+
+    timer tm;
+    dfa_string_dict dict;
+    const bool added = csv ? dict.add_strings_from_csv(args[1], csv_columns)
+                           : dict.add_strings_from_file(args[1]);
+    if(!added) {
+        std::cerr << msg_prefix1
+                  << "unable to add words from file " << args[1] << std::endl;
+        return 1;
+    }
+    std::cerr << msg_prefix1
+              << "words successfully added from file " << args[1] << " "
+              << tm.elapsed_time_str() << std::endl;
+
+    std::ifstream input_file;
+    std::ofstream output_file;
+    if(files.size() >= 1 && files[0] != "-") {
+        input_file.open(files[0], std::ios::binary);
+        if(!input_file.is_open()) {
+            std::cerr << msg_prefix1
+                      << "unable to open input file " << files[0] << std::endl;
+            return 1;
+        }
+    }
+    if(files.size() >= 2 && files[1] != "-") {
+        output_file.open(files[1], std::ios::binary);
+        if(!output_file.is_open()) {
+            std::cerr << msg_prefix1
+                      << "unable to open output file " << files[1] << std::endl;
+            return 1;
+        }
+    }
+
+    const spellcheck_pipeline pipeline(dict, opts);
+    const spellcheck_pipeline::stats &run_stats = pipeline.run(
+        input_file.is_open() ? input_file : std::cin,
+        output_file.is_open() ? output_file : std::cout
+    );
+    std::cerr << msg_prefix1 << "spell checked " << run_stats.descr() << std::endl;
+    return 0;
 }
 
 #endif // MAIN_UTILS_H
@@ -0,0 +1,328 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "spellcheck_pipeline.h"
+
+#include "bounded_queue.hpp"
+#include "timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Block of text read from input, ending at a word boundary.
+struct text_block {
+    std::uint64_t sequence {0}; // position of the block in input
+    std::uint64_t offset {0};   // offset of the first byte of the block in input
+    std::string text;
+};
+
+/// Words found in a text_block.
+struct word_batch {
+    std::uint64_t sequence {0};
+    std::uint64_t offset {0};
+    std::string text;
+    std::vector<std::pair<size_t, size_t>> words; // position and length in text
+};
+
+/// Result of matching a word_batch.
+struct result_batch {
+    std::uint64_t sequence {0};
+    std::uint64_t words {0};
+    std::uint64_t misspelled_words {0};
+    std::uint64_t corrected_words {0};
+    std::string lines; // output lines for misspelled words
+};
+
+/// Limits the number of batches being processed ahead of the next batch to
+/// write, since batches completed out of order must be kept by the writer.
+class sequence_window
+{
+public:
+    explicit sequence_window(std::uint64_t size) : m_size(size) {}
+
+    /// Waits until the batch with the given sequence number can be processed.
+    void wait_for(std::uint64_t sequence)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_advanced.wait(lock, [&]() { return sequence < m_next + m_size; });
+    }
+
+    /// Signals that the next batch has been written.
+    void advance()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_next++;
+        m_advanced.notify_all();
+    }
+
+private:
+    const std::uint64_t m_size;
+    std::uint64_t m_next {0};
+    std::mutex m_mutex;
+    std::condition_variable m_advanced;
+};
+
+bool is_trimmed_word_char(char c)
+{
+    return c == '-' || c == '\'';
+}
+
+} // namespace
+
+double spellcheck_pipeline::stats::megabytes_per_second() const
+{
+    return elapsed_time > 0 ? bytes / (1024.0 * 1024.0) / (elapsed_time / 1000) : 0;
+}
+
+double spellcheck_pipeline::stats::words_per_second() const
+{
+    return elapsed_time > 0 ? words / (elapsed_time / 1000) : 0;
+}
+
+std::string spellcheck_pipeline::stats::descr() const
+{
+    std::ostringstream stream;
+    stream << bytes << " bytes, "
+           << words << " words, "
+           << misspelled_words << " misspelled, "
+           << corrected_words << " corrected in "
+           << static_cast<long long>(elapsed_time) << " ms ("
+           << megabytes_per_second() << " MB/s, "
+           << static_cast<long long>(words_per_second()) << " words/s)";
+    return stream.str();
+}
+
+spellcheck_pipeline::spellcheck_pipeline(
+    const dfa_string_dict &dict,
+    const options &opts
+)
+    : m_dict(dict)
+    , m_options(opts)
+{
+    if(m_options.matcher_threads == 0) {
+        m_options.matcher_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(m_options.block_size == 0) {
+        m_options.block_size = options().block_size;
+    }
+}
+
+spellcheck_pipeline::stats spellcheck_pipeline::run(
+    std::istream &input,
+    std::ostream &output
+) const
+{
+    const options &opts = m_options;
+    const dfa_string_dict &dict = m_dict;
+
+    timer tm;
+    stats run_stats;
+
+    bounded_queue<text_block> blocks(opts.queue_capacity);
+    bounded_queue<word_batch> batches(opts.queue_capacity);
+    bounded_queue<result_batch> results(opts.queue_capacity);
+    sequence_window window(2 * opts.queue_capacity + opts.matcher_threads);
+
+    // Reader stage: blocks end at word boundaries so that no word is split
+    // between two blocks; the partial word at the end of a block is carried
+    // over to the next one.
+    std::thread reader([&]() {
+        std::string carry;
+        std::uint64_t sequence = 0;
+        std::uint64_t offset = 0;
+        bool end_reached = false;
+        while(!end_reached) {
+            text_block block;
+            block.text.swap(carry);
+            const size_t prev_length = block.text.length();
+            block.text.resize(prev_length + opts.block_size);
+            input.read(&block.text[prev_length], opts.block_size);
+            const size_t read_length = static_cast<size_t>(input.gcount());
+            block.text.resize(prev_length + read_length);
+            run_stats.bytes += read_length;
+            end_reached = read_length < opts.block_size;
+
+            if(!end_reached) {
+                size_t cut = block.text.length();
+                while(cut > 0 && is_word_char(block.text[cut-1])) {
+                    cut--;
+                }
+                if(cut == 0) {
+                    carry.swap(block.text); // the block is part of a single word
+                    continue;
+                }
+                carry.assign(block.text, cut, std::string::npos);
+                block.text.resize(cut);
+            }
+
+            block.sequence = sequence++;
+            block.offset = offset;
+            offset += block.text.length();
+            blocks.push(std::move(block));
+        }
+        blocks.close();
+    });
+
+    // Tokenizer stage.
+    std::thread tokenizer([&]() {
+        text_block block;
+        while(blocks.pop(block)) {
+            word_batch batch;
+            batch.sequence = block.sequence;
+            batch.offset = block.offset;
+            batch.text.swap(block.text);
+
+            const std::string &text = batch.text;
+            for(size_t i = 0; i < text.length(); ) {
+                if(!is_word_char(text[i])) {
+                    i++;
+                    continue;
+                }
+                size_t word_begin = i;
+                size_t word_end = i;
+                while(word_end < text.length() && is_word_char(text[word_end])) {
+                    word_end++;
+                }
+                i = word_end;
+
+                while(word_begin < word_end && is_trimmed_word_char(text[word_begin])) {
+                    word_begin++;
+                }
+                while(word_end > word_begin && is_trimmed_word_char(text[word_end-1])) {
+                    word_end--;
+                }
+                if(word_begin < word_end) {
+                    batch.words.push_back(std::make_pair(word_begin, word_end - word_begin));
+                }
+            }
+
+            window.wait_for(batch.sequence);
+            batches.push(std::move(batch));
+        }
+        batches.close();
+    });
+
+    // Matcher stage.
+    std::atomic<unsigned int> running_matchers(opts.matcher_threads);
+    std::vector<std::thread> matchers;
+    for(unsigned int t = 0; t < opts.matcher_threads; t++) {
+        matchers.emplace_back([&]() {
+            word_batch batch;
+            while(batches.pop(batch)) {
+                result_batch result;
+                result.sequence = batch.sequence;
+                result.words = batch.words.size();
+
+                std::string word;
+                std::string folded_word;
+                for(const auto &position : batch.words) {
+                    word.assign(batch.text, position.first, position.second);
+                    if(dict.contains_string(word)) {
+                        continue;
+                    }
+                    if(opts.fold_case) {
+                        folded_word = word;
+                        for(char &c : folded_word) {
+                            if(c >= 'A' && c <= 'Z') {
+                                c = static_cast<char>(c - 'A' + 'a');
+                            }
+                        }
+                        if(folded_word != word && dict.contains_string(folded_word)) {
+                            continue;
+                        }
+                    }
+                    else {
+                        folded_word = word;
+                    }
+
+                    const dfa_string_dict::match_result &match =
+                        dict.match_string_levenshtein_distance(folded_word, opts.edit_max);
+                    result.misspelled_words++;
+                    if(match.success) {
+                        result.corrected_words++;
+                    }
+                    result.lines += std::to_string(batch.offset + position.first);
+                    result.lines += '\t';
+                    result.lines += word;
+                    result.lines += '\t';
+                    result.lines += match.success ? match.matched : "";
+                    result.lines += '\n';
+                }
+                results.push(std::move(result));
+            }
+            if(--running_matchers == 0) {
+                results.close();
+            }
+        });
+    }
+
+    // Writer stage.
+    std::map<std::uint64_t, result_batch> pending_results;
+    std::uint64_t next_sequence = 0;
+    result_batch result;
+    while(results.pop(result)) {
+        const std::uint64_t sequence = result.sequence;
+        pending_results[sequence] = std::move(result);
+
+        auto it = pending_results.begin();
+        while(it != pending_results.end() && it->first == next_sequence) {
+            output << it->second.lines;
+            run_stats.words += it->second.words;
+            run_stats.misspelled_words += it->second.misspelled_words;
+            run_stats.corrected_words += it->second.corrected_words;
+            it = pending_results.erase(it);
+            next_sequence++;
+            window.advance();
+        }
+    }
+    output.flush();
+
+    reader.join();
+    tokenizer.join();
+    for(std::thread &matcher : matchers) {
+        matcher.join();
+    }
+
+    run_stats.elapsed_time = tm.elapsed_time();
+    return run_stats;
+}
+
+bool spellcheck_pipeline::is_word_char(char c)
+{
+    const unsigned char uc = static_cast<unsigned char>(c);
+    return (uc >= 'a' && uc <= 'z')
+        || (uc >= 'A' && uc <= 'Z')
+        || (uc >= '0' && uc <= '9')
+        || uc >= 0x80
+        || is_trimmed_word_char(c);
+}
@@ -0,0 +1,95 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef SPELLCHECK_PIPELINE_H
+#define SPELLCHECK_PIPELINE_H
+
+#include "dfa_string_dict.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/// Spell checks text read from a stream using a dfa_string_dict. The work is
+/// split into stages running in their own threads and connected by bounded
+/// queues, so that a slow stage holds back the previous ones instead of
+/// letting data pile up:
+///     - a reader reads the input in large blocks ending at word boundaries.
+///     - a tokenizer splits blocks into words.
+///     - a pool of matchers looks up each word exactly and, on failure, using
+///       match_string_levenshtein_distance().
+///     - a writer (the calling thread) writes the misspelled words in the
+///       order they appear in the input, whatever the order in which matchers
+///       complete their work.
+///
+/// One line is written per misspelled word:
+///     <byte offset in input>\t<word>\t<correction or empty if none>
+class spellcheck_pipeline
+{
+public:
+    struct options {
+        unsigned int matcher_threads {0}; // number of matcher threads (0 means one per hardware thread)
+        unsigned int edit_max {2};        // maximum cost when looking for corrections
+        bool fold_case {true};            // whether ASCII letters are lowercased before matching
+        size_t block_size {1 << 20};      // size of the blocks read from input in bytes
+        size_t queue_capacity {8};        // number of blocks or batches each queue can hold
+    };
+
+    /// Statistics about a run.
+    struct stats {
+        std::uint64_t bytes {0};           // number of bytes read
+        std::uint64_t words {0};           // number of words read
+        std::uint64_t misspelled_words {0}; // number of words not found exactly
+        std::uint64_t corrected_words {0}; // number of misspelled words for which a correction was found
+        double elapsed_time {0};           // in milliseconds
+
+        double megabytes_per_second() const;
+        double words_per_second() const;
+
+        /// Convenient informative function.
+        std::string descr() const;
+    };
+
+public:
+    explicit spellcheck_pipeline(const dfa_string_dict &dict,
+                                 const options &opts);
+
+    /// Spell checks input until its end and writes results to output. The
+    /// dictionary must not be modified in the meantime.
+    stats run(std::istream &input, std::ostream &output) const;
+
+    /// Returns whether the given character can be part of a word. Words are
+    /// sequences of ASCII letters and digits, non-ASCII bytes (e.g. UTF-8
+    /// encoded letters), hyphens and apostrophes, the last two being removed
+    /// from both ends of a word.
+    static bool is_word_char(char c);
+
+private:
+    const dfa_string_dict &m_dict;
+    options m_options;
+};
+
+#endif // SPELLCHECK_PIPELINE_H
@@ -0,0 +1,120 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "query_client.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+bool query_client::connect(const std::string &socket_path)
+{
+    disconnect();
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return fail("invalid socket path", 0);
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    m_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(m_fd < 0) {
+        return fail("cannot create socket", errno);
+    }
+    if(::connect(m_fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+        const int error_code = errno;
+        disconnect();
+        return fail("cannot connect to " + socket_path, error_code);
+    }
+    return true;
+}
+
+void query_client::disconnect()
+{
+    if(m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+    m_output.clear();
+    m_input.clear();
+    m_input_pos = 0;
+}
+
+bool query_client::flush()
+{
+    size_t pos = 0;
+    while(pos < m_output.size()) {
+        const ssize_t n = ::send(m_fd, m_output.data() + pos, m_output.size() - pos, MSG_NOSIGNAL);
+        if(n < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return fail("cannot send requests", errno);
+        }
+        pos += static_cast<size_t>(n);
+    }
+    m_output.clear();
+    return true;
+}
+
+bool query_client::receive(query_protocol::response &res)
+{
+    for(;;) {
+        const size_t read_count = query_protocol::decode_response(
+            m_input.data() + m_input_pos, m_input.size() - m_input_pos, res);
+        if(read_count > 0) {
+            m_input_pos += read_count;
+            return true;
+        }
+
+        // Drop decoded bytes before reading more.
+        m_input.erase(0, m_input_pos);
+        m_input_pos = 0;
+
+        char buffer[64 * 1024];
+        const ssize_t n = read(m_fd, buffer, sizeof(buffer));
+        if(n > 0) {
+            m_input.append(buffer, static_cast<size_t>(n));
+        }
+        else if(n == 0) {
+            return fail("connection closed by server", 0);
+        }
+        else if(errno != EINTR) {
+            return fail("cannot receive responses", errno);
+        }
+    }
+}
+
+bool query_client::fail(const std::string &what, int error_code)
+{
+    m_error = what + (error_code != 0 ? std::string(": ") + std::strerror(error_code) : "");
+    return false;
+}
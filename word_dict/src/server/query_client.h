@@ -0,0 +1,77 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef QUERY_CLIENT_H
+#define QUERY_CLIENT_H
+
+#include "query_protocol.hpp"
+
+#include <string>
+
+/// Blocking client for query_server. Requests are buffered by send() until
+/// flush() is called, so that several requests can be pipelined in a single
+/// system call.
+class query_client
+{
+public:
+    explicit query_client() {}
+
+    query_client(const query_client &) = delete;
+    query_client& operator=(const query_client &) = delete;
+
+    ~query_client() { disconnect(); }
+
+    /// Connects to the server listening on the given socket. Returns false on
+    /// failure, in which case error() describes the reason.
+    bool connect(const std::string &socket_path);
+
+    void disconnect();
+
+    /// Queues a request.
+    void send(const query_protocol::request &req)
+    { query_protocol::encode_request(req, m_output); }
+
+    /// Writes the queued requests. Returns false on failure.
+    bool flush();
+
+    /// Waits for the next response. Returns false on failure or if the server
+    /// closed the connection.
+    bool receive(query_protocol::response &res);
+
+    const std::string& error() const { return m_error; }
+
+private:
+    bool fail(const std::string &what, int error_code);
+
+private:
+    int m_fd {-1};
+    std::string m_output;
+    std::string m_input;
+    size_t m_input_pos {0}; // bytes of input already decoded
+    std::string m_error;
+};
+
+#endif // QUERY_CLIENT_H
@@ -0,0 +1,160 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef QUERY_PROTOCOL_H
+#define QUERY_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// Binary protocol used by query_server and its clients. Messages are framed
+/// as a fixed size header followed by a string, all integers being encoded in
+/// little-endian byte order:
+///     request:  [u32 id][u8 operation][u8 cost][u16 length][length bytes: string to match]
+///     response: [u32 id][u8 status][u8 cost][u16 length][length bytes: matched string]
+///
+/// Requests can be pipelined, i.e. sent without waiting for the responses to
+/// previous requests. Responses are not necessarily sent in request order:
+/// the id chosen by the client for a request is copied to its response.
+class query_protocol
+{
+public:
+    query_protocol() = delete;
+
+    enum class operation : std::uint8_t {
+        exact = 0,        // dfa_string_dict::match_string_exactly()
+        substitution = 1, // dfa_string_dict::match_string_allow_substitution()
+        levenshtein = 2,  // dfa_string_dict::match_string_levenshtein_distance()
+    };
+
+    enum class status : std::uint8_t {
+        not_found = 0,
+        found = 1,       // the matched string and the cost of the match are set
+        bad_request = 2, // unknown operation or cost exceeding the server limit
+        incomplete = 3,  // not found before the server time limit, the closest string found so far being set if any
+    };
+
+    struct request {
+        std::uint32_t id {0};
+        operation op {operation::exact};
+        std::uint8_t cost {0};
+        std::string str;
+    };
+
+    struct response {
+        std::uint32_t id {0};
+        status st {status::not_found};
+        std::uint8_t cost {0};
+        std::string matched;
+    };
+
+    static const size_t header_size = 8;
+    static const size_t string_length_max = 0xFFFF; // longer strings are truncated
+
+    /// Appends the encoded request to out.
+    static void encode_request(const request &req, std::string &out)
+    {
+        encode(req.id, static_cast<std::uint8_t>(req.op), req.cost, req.str, out);
+    }
+
+    /// Appends the encoded response to out.
+    static void encode_response(const response &res, std::string &out)
+    {
+        encode(res.id, static_cast<std::uint8_t>(res.st), res.cost, res.matched, out);
+    }
+
+    /// Decodes the request at the beginning of data. Returns the number of
+    /// bytes read, or 0 if data does not hold a complete request yet.
+    static size_t decode_request(const char *data, size_t size, request &req)
+    {
+        std::uint8_t op = 0;
+        const size_t read = decode(data, size, req.id, op, req.cost, req.str);
+        req.op = static_cast<operation>(op);
+        return read;
+    }
+
+    /// Decodes the response at the beginning of data. Same return value as
+    /// decode_request().
+    static size_t decode_response(const char *data, size_t size, response &res)
+    {
+        std::uint8_t st = 0;
+        const size_t read = decode(data, size, res.id, st, res.cost, res.matched);
+        res.st = static_cast<status>(st);
+        return read;
+    }
+
+private:
+    static void encode(std::uint32_t id,
+                       std::uint8_t code,
+                       std::uint8_t cost,
+                       const std::string &str,
+                       std::string &out)
+    {
+        const size_t length = str.length() < string_length_max
+                            ? str.length()
+                            : string_length_max;
+        const char header[header_size] = {
+            static_cast<char>(id & 0xFF),
+            static_cast<char>((id >> 8) & 0xFF),
+            static_cast<char>((id >> 16) & 0xFF),
+            static_cast<char>((id >> 24) & 0xFF),
+            static_cast<char>(code),
+            static_cast<char>(cost),
+            static_cast<char>(length & 0xFF),
+            static_cast<char>((length >> 8) & 0xFF),
+        };
+        out.append(header, header_size);
+        out.append(str, 0, length);
+    }
+
+    static size_t decode(const char *data,
+                         size_t size,
+                         std::uint32_t &id,
+                         std::uint8_t &code,
+                         std::uint8_t &cost,
+                         std::string &str)
+    {
+        if(size < header_size) {
+            return 0;
+        }
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+        const size_t length = bytes[6] | (static_cast<size_t>(bytes[7]) << 8);
+        if(size < header_size + length) {
+            return 0;
+        }
+        id = static_cast<std::uint32_t>(bytes[0])
+           | (static_cast<std::uint32_t>(bytes[1]) << 8)
+           | (static_cast<std::uint32_t>(bytes[2]) << 16)
+           | (static_cast<std::uint32_t>(bytes[3]) << 24);
+        code = bytes[4];
+        cost = bytes[5];
+        str.assign(data + header_size, length);
+        return header_size + length;
+    }
+};
+
+#endif // QUERY_PROTOCOL_H
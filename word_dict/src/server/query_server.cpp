@@ -0,0 +1,480 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "query_server.h"
+
+#include "bounded_queue.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+typedef std::chrono::steady_clock steady_clock_t;
+
+/// Request read from a connection.
+struct pending_request {
+    std::uint64_t connection_id {0};
+    query_protocol::request req;
+};
+
+/// Encoded responses to consecutive requests of a batch coming from the same
+/// connection.
+struct completed_responses {
+    std::uint64_t connection_id {0};
+    size_t count {0};
+    std::string data;
+};
+
+/// Queue through which workers hand responses back to the event loop. Unlike
+/// bounded_queue, pushing never blocks so that workers cannot wait for the
+/// event loop while the latter waits for them.
+class completion_queue
+{
+public:
+    /// Returns whether the queue was empty, in which case the event loop must
+    /// be woken up.
+    bool push(std::vector<completed_responses> &&responses)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const bool was_empty = m_responses.empty();
+        for(completed_responses &r : responses) {
+            m_responses.push_back(std::move(r));
+        }
+        return was_empty;
+    }
+
+    void take(std::vector<completed_responses> &responses)
+    {
+        responses.clear();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        responses.swap(m_responses);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<completed_responses> m_responses;
+};
+
+/// State of a client connection, only accessed by the event loop.
+struct connection {
+    int fd {-1};
+    std::string input;
+    std::string output;
+    size_t output_pos {0};    // bytes of output already written
+    size_t in_flight {0};     // requests dispatched but not answered yet
+    bool read_closed {false}; // the client will not send more requests
+    bool failed {false};      // the connection must be closed immediately
+};
+
+bool set_non_blocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/// Reads everything available from a connection.
+void read_input(connection &conn)
+{
+    char buffer[64 * 1024];
+    for(;;) {
+        const ssize_t n = read(conn.fd, buffer, sizeof(buffer));
+        if(n > 0) {
+            conn.input.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if(n == 0) {
+            conn.read_closed = true;
+        }
+        else if(errno == EINTR) {
+            continue;
+        }
+        else if(errno != EAGAIN && errno != EWOULDBLOCK) {
+            conn.failed = true;
+        }
+        return;
+    }
+}
+
+/// Writes as much pending output as possible to a connection.
+void write_output(connection &conn)
+{
+    while(conn.output_pos < conn.output.size()) {
+        const ssize_t n = send(conn.fd,
+                               conn.output.data() + conn.output_pos,
+                               conn.output.size() - conn.output_pos,
+                               MSG_NOSIGNAL);
+        if(n > 0) {
+            conn.output_pos += static_cast<size_t>(n);
+            continue;
+        }
+        if(n < 0 && errno == EINTR) {
+            continue;
+        }
+        if(n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            conn.failed = true;
+        }
+        return;
+    }
+    conn.output.clear();
+    conn.output_pos = 0;
+}
+
+} // namespace
+
+std::string query_server::stats::descr() const
+{
+    std::ostringstream stream;
+    stream << connections << " connections, "
+           << requests << " requests, "
+           << batches << " batches ("
+           << (batches > 0 ? static_cast<double>(requests) / batches : 0)
+           << " requests per batch)";
+    return stream.str();
+}
+
+query_server::query_server(const dfa_string_dict &dict, const options &opts)
+    : m_dict(dict)
+    , m_options(opts)
+{
+    if(m_options.worker_threads == 0) {
+        m_options.worker_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if(m_options.batch_size_max == 0) {
+        m_options.batch_size_max = 1;
+    }
+    if(pipe(m_wake_pipe) != 0
+        || !set_non_blocking(m_wake_pipe[0])
+        || !set_non_blocking(m_wake_pipe[1])) {
+        fail("cannot create wake-up pipe", errno);
+    }
+}
+
+query_server::~query_server()
+{
+    for(const int fd : m_wake_pipe) {
+        if(fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool query_server::run()
+{
+    if(!m_error.empty()) {
+        return false;
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(m_options.socket_path.empty()
+        || m_options.socket_path.size() >= sizeof(address.sun_path)) {
+        return fail("invalid socket path", 0);
+    }
+    std::strcpy(address.sun_path, m_options.socket_path.c_str());
+
+    const int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listen_fd < 0) {
+        return fail("cannot create socket", errno);
+    }
+    unlink(m_options.socket_path.c_str());
+    if(bind(listen_fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0
+        || listen(listen_fd, SOMAXCONN) != 0
+        || !set_non_blocking(listen_fd)) {
+        const int error_code = errno;
+        close(listen_fd);
+        return fail("cannot listen on " + m_options.socket_path, error_code);
+    }
+
+    const options &opts = m_options;
+    const dfa_string_dict &dict = m_dict;
+    m_stats = stats();
+
+    // Worker threads.
+    bounded_queue<std::vector<pending_request>> batches(opts.queue_capacity);
+    completion_queue completions;
+    const int wake_fd = m_wake_pipe[1];
+    std::vector<std::thread> workers;
+    for(unsigned int t = 0; t < opts.worker_threads; t++) {
+        workers.emplace_back([&]() {
+            std::vector<pending_request> batch;
+            std::vector<completed_responses> responses;
+            while(batches.pop(batch)) {
+                responses.clear();
+                for(const pending_request &pending : batch) {
+                    if(responses.empty()
+                        || responses.back().connection_id != pending.connection_id) {
+                        responses.emplace_back();
+                        responses.back().connection_id = pending.connection_id;
+                    }
+                    completed_responses &r = responses.back();
+                    query_protocol::encode_response(
+                        answer(dict, pending.req, opts.cost_max, opts.query_time_max_us), r.data);
+                    r.count++;
+                }
+                if(completions.push(std::move(responses))) {
+                    const char byte = 0;
+                    (void)!write(wake_fd, &byte, 1); // a full pipe already wakes the event loop up
+                }
+            }
+        });
+    }
+
+    // Event loop.
+    std::unordered_map<std::uint64_t, connection> connections;
+    std::uint64_t next_connection_id = 0;
+    std::vector<pending_request> batch;
+    steady_clock_t::time_point batch_start;
+    const std::chrono::microseconds batch_delay(opts.batch_delay_us);
+
+    auto dispatch_batch = [&]() {
+        m_stats.batches++;
+        batches.push(std::move(batch));
+        batch = std::vector<pending_request>();
+        batch.reserve(opts.batch_size_max);
+    };
+
+    std::vector<pollfd> fds;
+    std::vector<std::uint64_t> fd_connection_ids;
+    std::vector<completed_responses> completed;
+    int loop_error_code = 0;
+    while(!m_stop_requested) {
+        fds.clear();
+        fd_connection_ids.clear();
+        fds.push_back({listen_fd, POLLIN, 0});
+        fds.push_back({m_wake_pipe[0], POLLIN, 0});
+        for(const auto &entry : connections) {
+            const connection &conn = entry.second;
+            short events = 0;
+            if(conn.output_pos < conn.output.size()) {
+                events |= POLLOUT;
+            }
+            if(!conn.read_closed && conn.output.size() - conn.output_pos <= opts.output_buffer_max) {
+                events |= POLLIN;
+            }
+            fds.push_back({events != 0 ? conn.fd : -1, events, 0}); // negative fds are ignored
+            fd_connection_ids.push_back(entry.first);
+        }
+
+        // Wait for events, or until the current batch must be dispatched.
+        timespec timeout;
+        timespec *timeout_ptr = nullptr;
+        if(!batch.empty()) {
+            const auto remaining = std::max(
+                steady_clock_t::duration::zero(),
+                batch_start + batch_delay - steady_clock_t::now()
+            );
+            const auto remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+            timeout.tv_sec = static_cast<time_t>(remaining_ns / 1000000000);
+            timeout.tv_nsec = static_cast<long>(remaining_ns % 1000000000);
+            timeout_ptr = &timeout;
+        }
+        if(ppoll(fds.data(), fds.size(), timeout_ptr, nullptr) < 0 && errno != EINTR) {
+            loop_error_code = errno;
+            break;
+        }
+
+        // Responses completed by workers.
+        if(fds[1].revents & POLLIN) {
+            char buffer[256];
+            while(read(m_wake_pipe[0], buffer, sizeof(buffer)) > 0) {}
+        }
+        completions.take(completed);
+        for(completed_responses &r : completed) {
+            m_stats.requests += r.count;
+            const auto it = connections.find(r.connection_id);
+            if(it != connections.end()) {
+                it->second.in_flight -= r.count;
+                it->second.output += r.data;
+            }
+        }
+
+        // New connections.
+        if(fds[0].revents & POLLIN) {
+            for(;;) {
+                const int fd = accept(listen_fd, nullptr, nullptr);
+                if(fd < 0) {
+                    break;
+                }
+                if(!set_non_blocking(fd)) {
+                    close(fd);
+                    continue;
+                }
+                connection &conn = connections[next_connection_id++];
+                conn.fd = fd;
+                m_stats.connections++;
+            }
+        }
+
+        // Incoming requests.
+        for(size_t i = 2; i < fds.size(); i++) {
+            if(!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            const std::uint64_t connection_id = fd_connection_ids[i-2];
+            connection &conn = connections[connection_id];
+            read_input(conn);
+
+            size_t pos = 0;
+            for(;;) {
+                pending_request pending;
+                const size_t read = query_protocol::decode_request(
+                    conn.input.data() + pos, conn.input.size() - pos, pending.req);
+                if(read == 0) {
+                    break;
+                }
+                pos += read;
+                pending.connection_id = connection_id;
+                if(batch.empty()) {
+                    batch_start = steady_clock_t::now();
+                }
+                batch.push_back(std::move(pending));
+                conn.in_flight++;
+                if(batch.size() >= opts.batch_size_max) {
+                    dispatch_batch();
+                }
+            }
+            conn.input.erase(0, pos);
+        }
+
+        if(!batch.empty() && steady_clock_t::now() - batch_start >= batch_delay) {
+            dispatch_batch();
+        }
+
+        // Outgoing responses, and connections to close.
+        for(auto it = connections.begin(); it != connections.end(); ) {
+            connection &conn = it->second;
+            if(!conn.failed) {
+                write_output(conn);
+            }
+            const bool done = conn.read_closed
+                           && conn.in_flight == 0
+                           && conn.output_pos == conn.output.size();
+            if(conn.failed || done) {
+                close(conn.fd);
+                it = connections.erase(it);
+            }
+            else {
+                it++;
+            }
+        }
+    }
+
+    batches.close();
+    for(std::thread &worker : workers) {
+        worker.join();
+    }
+    for(const auto &entry : connections) {
+        close(entry.second.fd);
+    }
+    close(listen_fd);
+    unlink(m_options.socket_path.c_str());
+
+    return loop_error_code == 0 || fail("cannot wait for socket events", loop_error_code);
+}
+
+void query_server::stop()
+{
+    m_stop_requested = true;
+    const char byte = 0;
+    (void)!write(m_wake_pipe[1], &byte, 1);
+}
+
+query_protocol::response query_server::answer(
+    const dfa_string_dict &dict,
+    const query_protocol::request &req,
+    unsigned int cost_max,
+    unsigned int query_time_max_us
+)
+{
+    query_protocol::response res;
+    res.id = req.id;
+    if(req.cost > cost_max) {
+        res.st = query_protocol::status::bad_request;
+        return res;
+    }
+
+    dfa_string_dict::search_limits limits;
+    if(query_time_max_us != 0 && req.op != query_protocol::operation::exact) {
+        limits = dfa_string_dict::search_limits::within(
+            std::chrono::microseconds(query_time_max_us));
+    }
+
+    dfa_string_dict::match_result match;
+    switch(req.op) {
+    case query_protocol::operation::exact:
+        // Avoid building a match_result in the most common case.
+        match.success = dict.contains_string(req.str);
+        match.setMatched(req.str, 0);
+        break;
+    case query_protocol::operation::substitution:
+        match = query_time_max_us == 0
+              ? dict.match_string_allow_substitution(req.str, req.cost)
+              : dict.match_string_allow_substitution(req.str, req.cost, limits);
+        break;
+    case query_protocol::operation::levenshtein:
+        match = query_time_max_us == 0
+              ? dict.match_string_levenshtein_distance(req.str, req.cost)
+              : dict.match_string_levenshtein_distance(req.str, req.cost, limits);
+        break;
+    default:
+        res.st = query_protocol::status::bad_request;
+        return res;
+    }
+
+    if(match.success) {
+        res.st = query_protocol::status::found;
+        res.cost = static_cast<std::uint8_t>(match.cost);
+        res.matched = match.matched;
+    }
+    else if(!match.complete) {
+        res.st = query_protocol::status::incomplete;
+        res.cost = static_cast<std::uint8_t>(std::min(match.cost, 0xFFu));
+        res.matched = match.matched;
+    }
+    return res;
+}
+
+bool query_server::fail(const std::string &what, int error_code)
+{
+    m_error = what + (error_code != 0 ? std::string(": ") + std::strerror(error_code) : "");
+    return false;
+}
@@ -0,0 +1,114 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include "dfa_string_dict.h"
+#include "query_protocol.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// Answers queries about a dfa_string_dict over a Unix domain socket, using
+/// query_protocol.
+///
+/// A single event loop thread accepts connections and reads and writes all
+/// sockets in non-blocking mode. Requests read from any connection are
+/// gathered into batches, which are dispatched to a pool of worker threads
+/// once they are full or once their oldest request has waited for the batch
+/// delay; batching amortizes the cost of synchronizing with workers over many
+/// requests. Workers hand the responses back to the event loop, which writes
+/// them to their connection.
+class query_server
+{
+public:
+    struct options {
+        std::string socket_path;            // path of the Unix domain socket (replaced if it exists)
+        unsigned int worker_threads {0};    // number of worker threads (0 means one per hardware thread)
+        size_t batch_size_max {64};         // maximum number of requests per batch
+        unsigned int batch_delay_us {50};   // maximum time a request waits for its batch to be full, in microseconds
+        size_t queue_capacity {64};         // number of batches waiting for workers
+        unsigned int cost_max {4};          // requests with a larger cost are rejected
+        unsigned int query_time_max_us {0}; // time after which fuzzy searches stop, in microseconds (0 means no limit)
+        size_t output_buffer_max {1 << 20}; // connections stop being read while more bytes than this wait to be written
+    };
+
+    /// Statistics about a run.
+    struct stats {
+        std::uint64_t connections {0}; // number of connections accepted
+        std::uint64_t requests {0};    // number of requests answered
+        std::uint64_t batches {0};     // number of batches dispatched to workers
+
+        /// Convenient informative function.
+        std::string descr() const;
+    };
+
+public:
+    explicit query_server(const dfa_string_dict &dict, const options &opts);
+
+    query_server(const query_server &) = delete;
+    query_server& operator=(const query_server &) = delete;
+
+    ~query_server();
+
+    /// Creates the socket and serves queries until stop() is called. Returns
+    /// false if the socket could not be created, in which case error()
+    /// describes the reason. The dictionary must not be modified in the
+    /// meantime.
+    bool run();
+
+    /// Makes run() return as soon as possible. Can be called from any thread
+    /// and from a signal handler.
+    void stop();
+
+    const stats& run_stats() const { return m_stats; }
+
+    const std::string& error() const { return m_error; }
+
+    /// Computes the response to a request, bounding fuzzy searches by
+    /// query_time_max_us unless it is 0.
+    static query_protocol::response answer(const dfa_string_dict &dict,
+                                           const query_protocol::request &req,
+                                           unsigned int cost_max,
+                                           unsigned int query_time_max_us = 0);
+
+private:
+    /// Sets error() from the given description and errno value (0 if none).
+    /// Always returns false.
+    bool fail(const std::string &what, int error_code);
+
+private:
+    const dfa_string_dict &m_dict;
+    options m_options;
+    stats m_stats;
+    std::string m_error;
+    std::atomic<bool> m_stop_requested {false};
+    int m_wake_pipe[2] {-1, -1}; // written to wake the event loop up
+};
+
+#endif // QUERY_SERVER_H
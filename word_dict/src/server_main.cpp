@@ -0,0 +1,143 @@
+/*
+ This file is part of https://github.com/arlogy/algos.
+
+ MIT License
+
+ Copyright (c) 2026 https://github.com/arlogy
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include "query_server.h"
+#include "timer.hpp"
+
+#include <csignal>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+query_server *running_server = nullptr;
+
+void handle_stop_signal(int)
+{
+    if(running_server) {
+        running_server->stop();
+    }
+}
+
+void print_usage(const std::string &program)
+{
+    std::cerr << "usage: " << program << " <dictionary file> <socket path>"
+                 " [--threads <count>] [--batch-size <count>]"
+                 " [--batch-delay-us <delay>] [--cost-max <cost>]"
+                 " [--query-time-max-us <time>]"
+                 " [--qgram-index] [--bidirectional-search] [--exact-filter]" << std::endl
+              << std::endl
+              << "Answers word queries on a Unix domain socket until"
+                 " interrupted (see query_protocol.hpp)." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const std::vector<std::string> args(argv + 1, argv + argc);
+    if(args.size() < 2) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    query_server::options opts;
+    opts.socket_path = args[1];
+    bool qgram_index = false;
+    bool bidirectional_search = false;
+    bool exact_filter = false;
+    try {
+        for(size_t i = 2; i < args.size(); i++) {
+            if(args[i] == "--threads" && i + 1 < args.size()) {
+                opts.worker_threads = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--batch-size" && i + 1 < args.size()) {
+                opts.batch_size_max = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--batch-delay-us" && i + 1 < args.size()) {
+                opts.batch_delay_us = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--cost-max" && i + 1 < args.size()) {
+                opts.cost_max = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--query-time-max-us" && i + 1 < args.size()) {
+                opts.query_time_max_us = std::stoul(args[++i]);
+            }
+            else if(args[i] == "--qgram-index") {
+                qgram_index = true;
+            }
+            else if(args[i] == "--bidirectional-search") {
+                bidirectional_search = true;
+            }
+            else if(args[i] == "--exact-filter") {
+                exact_filter = true;
+            }
+            else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch(const std::logic_error &) { // std::invalid_argument or std::out_of_range
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    timer tm;
+    dfa_string_dict dict;
+    if(!dict.add_strings_from_file(args[0])) {
+        std::cerr << "[-] unable to add words from file " << args[0] << std::endl;
+        return 1;
+    }
+    if(qgram_index) {
+        dict.enable_qgram_index();
+    }
+    if(bidirectional_search) {
+        dict.enable_bidirectional_search();
+    }
+    if(exact_filter) {
+        dict.enable_exact_filter();
+    }
+    std::cerr << "[-] words successfully added from file " << args[0] << " "
+              << tm.elapsed_time_str() << std::endl;
+
+    query_server server(dict, opts);
+    running_server = &server;
+    std::signal(SIGINT, handle_stop_signal);
+    std::signal(SIGTERM, handle_stop_signal);
+
+    std::cerr << "[-] listening on " << opts.socket_path << std::endl;
+    const bool ok = server.run();
+    running_server = nullptr;
+    if(!ok) {
+        std::cerr << "[-] " << server.error() << std::endl;
+        return 1;
+    }
+    std::cerr << "[-] served " << server.run_stats().descr() << std::endl;
+    return 0;
+}